@@ -0,0 +1,308 @@
+#include "AllPairsSearcher.hpp"
+
+// Вспомогательная функция вычисления потенциалов вершин алгоритмом Беллмана-Форда.
+// Фиктивная вершина не создается: ее наличие эквивалентно начальным значениям
+// h[v] = 0 для всех вершин. Возвращает false, если после V итераций значения
+// продолжают уменьшаться (в графе есть цикл отрицательной стоимости).
+template<typename Graph, typename Stats>
+bool AllPairsSearcher<Graph, Stats>::potentials(const Graph &G, vector<int> &h, Stats &stats) {
+	int n = G.V();
+	h.assign(n, 0);
+	for(int round = 0; round <= n; ++round) {
+		bool changed = false;
+		for(int u = 0; u < n; ++u) {
+			stats.expand();
+			typename Graph::adjIterator iter(G, u);
+			for(int i = iter.begin(); !iter.end(); i = iter.next(), stats.scan())
+				if(h[u] + iter.cost() < h[i]) {
+					h[i] = h[u] + iter.cost();
+					changed = true;
+				}
+		}
+		if(!changed)
+			return true;
+	}
+	return false;
+}
+
+// Вспомогательная функция, вычисляющая строки матриц поиском Дейкстры. Стартовые
+// вершины выдаются потокам по одной через атомарный счетчик, что выравнивает
+// нагрузку при разных размерах достижимых областей. Каждый поток использует
+// собственную кучу; строка расстояний sp_matrix служит буфером поиска.
+// При перевзвешивании стоимость ребра (u, i) равна c + h[u] - h[i] >= 0, а
+// итоговые расстояния восстанавливаются как d' - h[s] + h[w]. Раскрытые вершины и
+// просмотренные дуги подсчитываются каждым потоком отдельно и суммируются после
+// завершения пула.
+template<typename Graph, typename Stats>
+void AllPairsSearcher<Graph, Stats>::run_dijkstra(const vector<int> &sources, SearchControl *control) {
+	if(sources.empty())
+		return;
+	atomic<int> next_source(0);
+	int n = sources.size();
+	ThreadPool pool(min(threads > 0 ? threads : (int)thread::hardware_concurrency(), n));
+	bool reweight = !h.empty();
+	vector<long long> expanded(pool.size(), 0), scanned(pool.size(), 0);
+
+	pool.run([&](int t) {
+		DaryHeap<4> heap(v_cnt);
+		for(int k = next_source++; k < n; k = next_source++) {
+			if(control && !control->poll())
+				return;
+			int s = sources[k];
+			int *dist = &sp_matrix[(size_t)s * v_cnt];
+			int *pred = &sp_pred[(size_t)s * v_cnt];
+			fill(dist, dist + v_cnt, INF_COST);
+			fill(pred, pred + v_cnt, -1);
+
+			dist[s] = 0;
+			heap.push(s, 0);
+			while(!heap.empty()) {
+				int u = heap.pop();
+				++expanded[t];
+				typename Graph::adjIterator iter(G, u);
+				for(int i = iter.begin(); !iter.end(); i = iter.next()) {
+					++scanned[t];
+					int d = dist[u] + iter.cost() + (reweight ? h[u] - h[i] : 0);
+					if(d < dist[i]) {
+						dist[i] = d;
+						pred[i] = u;
+						heap.push(i, d);
+					}
+				}
+			}
+
+			if(reweight)
+				for(int w = 0; w < v_cnt; ++w)
+					if(dist[w] != INF_COST)
+						dist[w] += h[w] - h[s];
+		}
+	});
+	for(size_t t = 0; t < expanded.size(); ++t) {
+		stats.expand(expanded[t]);
+		stats.scan(scanned[t]);
+	}
+}
+
+// Вспомогательная функция выбора алгоритма и вычисления матриц. При m = AUTO
+// алгоритм Флойда выбирается, если оценка стоимости V поисков Дейкстры,
+// V * E * log2(V), превышает V^3 / 8 (векторизованное ядро Флойда обрабатывает по
+// несколько элементов за инструкцию). Потенциалы вычисляются на этапе подготовки.
+template<typename Graph, typename Stats>
+void AllPairsSearcher<Graph, Stats>::compute(method m, SearchControl *control) {
+	stats.begin(QueryStats::SETUP);
+	used = m;
+	h.clear();
+	if(used == AUTO) {
+		long long log_v = 1;
+		while((1LL << log_v) < v_cnt)
+			++log_v;
+		used = ((long long)G.E() * log_v * 8 >= (long long)v_cnt * v_cnt ? FLOYD : DIJKSTRA);
+	}
+	if(used != FLOYD) {
+		if(!potentials(G, h, stats))
+			used = FLOYD;
+		else if(used == JOHNSON || any_of(h.begin(), h.end(), [](int x) { return x < 0; }))
+			used = JOHNSON;
+		else
+			h.clear();
+	}
+
+	if(used == FLOYD) {
+		h.clear();
+		vector<int>().swap(sp_matrix);
+		vector<int>().swap(sp_pred);
+		floyd.reset(new ShortestPathSearcher<Graph, Stats>(G, threads, control));
+		return;
+	}
+
+	sp_matrix.assign((size_t)v_cnt * v_cnt, INF_COST);
+	sp_pred.assign((size_t)v_cnt * v_cnt, -1);
+	stats.allocate(2LL * v_cnt * v_cnt * sizeof(int));
+	stats.begin(QueryStats::SEARCH);
+	vector<int> sources(v_cnt);
+	for(int s = 0; s < v_cnt; ++s)
+		sources[s] = s;
+	run_dijkstra(sources, control);
+}
+
+// Вспомогательная функция обновления матриц после добавления (удешевления) дуги
+// (a, b) стоимостью c. Новый кратчайший путь из s в t, если он появился, имеет вид
+// s-...-a-b-...-t, поэтому для каждой строки s, в которой путь в b через дугу
+// стал короче, строка дополняется строкой b: d[s][t] = min(d[s][t], d[s][a] + c +
+// d[b][t]), предком t становится предок t в строке b (для t = b - вершина a).
+// Потенциалы остаются допустимыми (проверяется в edge_changed()), поэтому циклов
+// отрицательной стоимости нет и строка b не изменяется.
+template<typename Graph, typename Stats>
+void AllPairsSearcher<Graph, Stats>::insert_arc(int a, int b, int c) {
+	const int *db = &sp_matrix[(size_t)b * v_cnt], *pb = &sp_pred[(size_t)b * v_cnt];
+	for(int s = 0; s < v_cnt; ++s) {
+		int *ds = &sp_matrix[(size_t)s * v_cnt], *ps = &sp_pred[(size_t)s * v_cnt];
+		if(ds[a] == INF_COST || ds[a] + c >= ds[b])
+			continue;
+		stats.expand();
+		int base = ds[a] + c;
+		for(int t = 0; t < v_cnt; ++t)
+			if(db[t] != INF_COST && base + db[t] < ds[t]) {
+				ds[t] = base + db[t];
+				ps[t] = (t == b ? a : pb[t]);
+			}
+	}
+}
+
+// Конструктор. Вычисляет матрицы (см. compute()) и подписывается на изменения графа G.
+template<typename Graph, typename Stats>
+AllPairsSearcher<Graph, Stats>::AllPairsSearcher(const Graph &graph, int threads, method m,
+		SearchControl *control) :
+	G(graph), v_cnt(graph.V()), threads(threads), requested(m), used(m)
+{
+	stats.reset();
+	compute(m, control);
+	stats.end();
+	G.subscribe(this);
+}
+
+// Деструктор. Отписывается от изменений графа G.
+template<typename Graph, typename Stats>
+AllPairsSearcher<Graph, Stats>::~AllPairsSearcher() { G.unsubscribe(this); }
+
+// Вспомогательная функция обработки изменения дуги (v, w) графа G. Добавление и удешевление дуги
+// обрабатываются функцией insert_arc(), если приведенная стоимость дуги
+// c + h[v] - h[w] неотрицательна, иначе матрицы вычисляются заново. При удалении и
+// удорожании дуги потенциалы остаются допустимыми, а изменяются только строки s,
+// в деревьях кратчайших путей которых w достигается по этой дуге (предок w равен v):
+// в остальных строках дерево остается корректным.
+template<typename Graph, typename Stats>
+void AllPairsSearcher<Graph, Stats>::update(int v, int w, int old_c, int new_c) {
+	if(new_c != 0 && (old_c == 0 || new_c < old_c)) {
+		if(new_c + (h.empty() ? 0 : h[v] - h[w]) < 0)
+			compute(requested, nullptr);
+		else
+			insert_arc(v, w, new_c);
+		return;
+	}
+	if(old_c == 0 || new_c == old_c)
+		return;
+
+	vector<int> rows;
+	for(int s = 0; s < v_cnt; ++s)
+		if(sp_pred[(size_t)s * v_cnt + w] == v)
+			rows.push_back(s);
+	run_dijkstra(rows, nullptr);
+}
+
+// Функция обработки изменения дуги (v, w) графа G (см. GraphObserver). В режиме
+// FLOYD изменения обрабатывает ShortestPathSearcher.
+template<typename Graph, typename Stats>
+void AllPairsSearcher<Graph, Stats>::edge_changed(int v, int w, int old_c, int new_c) {
+	if(floyd)
+		return;
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	update(v, w, old_c, new_c);
+	stats.end();
+}
+
+// Функция возвращает алгоритм, использованный для вычисления путей.
+template<typename Graph, typename Stats>
+typename AllPairsSearcher<Graph, Stats>::method AllPairsSearcher<Graph, Stats>::algorithm() const {
+	return used;
+}
+
+// Функция возвращает стоимость кратчайшего пути от вершины v до вершины w
+// либо INF_COST, если пути не существует.
+template<typename Graph, typename Stats>
+int AllPairsSearcher<Graph, Stats>::distance(int v, int w) const {
+	if(floyd)
+		return floyd->distance(v, w);
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	int d = sp_matrix[(size_t)v * v_cnt + w];
+	stats.end();
+	return d;
+}
+
+// Функция возвращает вершину, предшествующую w на кратчайшем пути от v.
+template<typename Graph, typename Stats>
+int AllPairsSearcher<Graph, Stats>::predecessor(int v, int w) const {
+	if(floyd)
+		return floyd->predecessor(v, w);
+	return sp_pred[(size_t)v * v_cnt + w];
+}
+
+// Вспомогательная функция восстановления существующего пути от вершины v до
+// вершины w по строке v матрицы предков (этап восстановления).
+template<typename Graph, typename Stats>
+vector<int> AllPairsSearcher<Graph, Stats>::trace(int v, int w) const {
+	stats.begin(QueryStats::RECONSTRUCTION);
+	vector<int> res;
+	const int *pred = &sp_pred[(size_t)v * v_cnt];
+	PathTracer::from_predecessors([&](int u) { return pred[u]; }, v, w, res);
+	stats.path();
+	stats.allocate(res.size() * sizeof(int));
+	return res;
+}
+
+// Функция записывает кратчайший путь от вершины v до вершины w в буфер buf.
+template<typename Graph, typename Stats>
+int AllPairsSearcher<Graph, Stats>::path(int v, int w, int *buf, int capacity) const {
+	if(floyd)
+		return floyd->path(v, w, buf, capacity);
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	int n = 0;
+	if(sp_matrix[(size_t)v * v_cnt + w] != INF_COST) {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		const int *pred = &sp_pred[(size_t)v * v_cnt];
+		n = PathTracer::from_predecessors([&](int u) { return pred[u]; }, v, w, buf, capacity);
+		if(n > 0)
+			stats.path();
+	}
+	stats.end();
+	return n;
+}
+
+// Функция возвращает кратчайший путь от вершины v до вершины w в виде вектора.
+template<typename Graph, typename Stats>
+vector<int> AllPairsSearcher<Graph, Stats>::path(int v, int w) const {
+	if(floyd)
+		return floyd->path(v, w);
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	vector<int> res;
+	if(sp_matrix[(size_t)v * v_cnt + w] != INF_COST)
+		res = trace(v, w);
+	stats.end();
+	return res;
+}
+
+// Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+// w и его стоимостью в формате: "v-k1-k2-...-kn-w, P". Путь восстанавливается
+// по строке v матрицы предков от вершины w к вершине v.
+template<typename Graph, typename Stats>
+string AllPairsSearcher<Graph, Stats>::get_path(int v, int w) const {
+	if(floyd)
+		return floyd->get_path(v, w);
+
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	int d = sp_matrix[(size_t)v * v_cnt + w];
+	string res;
+	if(d == INF_COST) {
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(v, w);
+	}
+	else {
+		vector<int> path = trace(v, w);
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(path, d);
+	}
+	stats.allocate(res.size());
+	stats.end();
+	return res;
+}
+
+// Функция возвращает статистику последней операции.
+template<typename Graph, typename Stats>
+const Stats &AllPairsSearcher<Graph, Stats>::statistics() const {
+	return floyd ? floyd->statistics() : stats;
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#ifndef _ALL_PAIRS_SEARCHER_
+#define _ALL_PAIRS_SEARCHER_
+
+#include "main_header.hpp"
+#include "PathTracer.hpp"
+#include "DaryHeap.hpp"
+#include "ThreadPool.hpp"
+#include "ShortestPathSearcher.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс поиска кратчайших путей между всеми парами вершин графа Graph
+ * с автоматическим выбором алгоритма по плотности графа.
+ * ~~~~ Примечания:
+ * Для плотных графов используется блочный алгоритм Флойда (ShortestPathSearcher).
+ * Для разреженных графов выполняется V независимых поисков Дейкстры (по одному
+ * из каждой вершины), распределенных между потоками пула; у каждого потока своя
+ * куча, а результаты записываются непосредственно в строки общих матриц
+ * расстояний и предков. Если в графе есть ребра отрицательной стоимости, ребра
+ * предварительно перевзвешиваются потенциалами Беллмана-Форда (алгоритм Джонсона).
+ * При наличии цикла отрицательной стоимости используется алгоритм Флойда.
+ * Вычисление можно прервать (см. SearchControl): поиски Дейкстры проверяют
+ * остановку перед каждой стартовой вершиной, алгоритм Флойда - см.
+ * ShortestPathSearcher. Строки невычисленных стартовых вершин не содержат путей.
+ * Во всех режимах матрицы поддерживаются актуальными при изменении графа (см.
+ * GraphObserver): в режиме FLOYD - средствами ShortestPathSearcher, в режимах
+ * DIJKSTRA и JOHNSON добавление (удешевление) дуги обрабатывается за O(V^2), а
+ * при удалении (удорожании) дуги заново вычисляются только строки, в деревьях
+ * кратчайших путей которых она лежит. Если новая дуга нарушает потенциалы
+ * (отрицательная стоимость в режиме DIJKSTRA), алгоритм выбирается и матрицы
+ * вычисляются заново.
+ * Stats - политика статистики (см. NoStats, CountingStats): статистику сбрасывают
+ * вычисление матриц в конструкторе, обработка изменения графа и запросы
+ * distance(), path() и get_path(). Вычисление учитывает раскрытые вершины и
+ * просмотренные дуги алгоритма Беллмана-Форда (этап подготовки) и поисков
+ * Дейкстры (этап поиска); запрос - чтение матрицы (поиск), восстановление пути и
+ * форматирование строки. В режиме FLOYD статистику собирает ShortestPathSearcher.
+ * С CountingStats запросы не выполняются одновременно из нескольких потоков.
+*/
+template<typename Graph, typename Stats = NoStats>
+class AllPairsSearcher : public GraphObserver {
+public:
+	/* Алгоритм вычисления кратчайших путей. */
+	enum method { AUTO, FLOYD, DIJKSTRA, JOHNSON };
+private:
+	const Graph &G;
+	int v_cnt, threads;
+	/* Запрошенный (requested) и использованный (used) алгоритмы. */
+	method requested, used;
+	/* Потенциалы вершин в режиме JOHNSON (в остальных режимах вектор пуст). */
+	vector<int> h;
+	/*
+	 * sp_matrix[v * V + w] - стоимость кратчайшего пути из v в w;
+	 * sp_pred[v * V + w] - вершина, предшествующая w на этом пути (-1 для w = v
+	 * и для недостижимых вершин). Используются в режимах DIJKSTRA и JOHNSON.
+	*/
+	vector<int> sp_matrix, sp_pred;
+	/* Результат алгоритма Флойда (режим FLOYD). */
+	unique_ptr<ShortestPathSearcher<Graph, Stats>> floyd;
+	/* Статистика последней операции в режимах DIJKSTRA и JOHNSON. */
+	mutable Stats stats;
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Вспомогательная функция вычисления потенциалов вершин алгоритмом Беллмана-Форда
+	 * от фиктивной вершины, соединенной со всеми вершинами ребрами нулевой стоимости.
+	 * ~~~~ Примечания:
+	 * Возвращает false, если в графе есть цикл отрицательной стоимости. Раскрытые
+	 * вершины и просмотренные дуги учитываются в stats.
+	*/
+	static bool potentials(const Graph &G, vector<int> &h, Stats &stats);
+
+	/*
+	 * Вспомогательная функция, вычисляющая строки матриц для стартовых вершин
+	 * sources, выдаваемых потокам пула (с перевзвешиванием потенциалами h, если
+	 * они заданы); control - управление вычислением (nullptr - без ограничений).
+	*/
+	void run_dijkstra(const vector<int> &sources, SearchControl *control);
+
+	/* Вспомогательная функция выбора алгоритма m и вычисления всех матриц. */
+	void compute(method m, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция обновления матриц после добавления (удешевления)
+	 * дуги (a, b) стоимостью c за O(V^2) (режимы DIJKSTRA и JOHNSON).
+	*/
+	void insert_arc(int a, int b, int c);
+
+	/* Вспомогательная функция обработки изменения дуги (см. edge_changed()) без сброса статистики. */
+	void update(int v, int w, int old_c, int new_c);
+
+	/* Вспомогательная функция восстановления существующего пути от v до w (см. path()). */
+	vector<int> trace(int v, int w) const;
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; threads - количество потоков (0 - по количеству аппаратных потоков);
+	 * m - алгоритм (AUTO - выбор по плотности графа и знакам стоимостей ребер);
+	 * control - управление вычислением (nullptr - без ограничений; используется
+	 * только в конструкторе).
+	*/
+	AllPairsSearcher(const Graph &G, int threads = 0, method m = AUTO,
+		SearchControl *control = nullptr);
+
+	/* Деструктор. Отписывается от изменений графа. */
+	~AllPairsSearcher();
+
+	/* Копирование запрещено: экземпляр зарегистрирован в графе по адресу. */
+	AllPairsSearcher(const AllPairsSearcher &) = delete;
+	AllPairsSearcher &operator=(const AllPairsSearcher &) = delete;
+
+	/*
+	 * Функция обработки изменения дуги (v, w) графа (см. GraphObserver). Вызывается
+	 * графом; вызывать напрямую не требуется.
+	*/
+	void edge_changed(int v, int w, int old_c, int new_c) override;
+
+	/* Функция возвращает алгоритм, использованный для вычисления путей. */
+	inline method algorithm() const;
+
+	/*
+	 * Функция возвращает стоимость кратчайшего пути от вершины v до вершины w
+	 * либо INF_COST, если пути не существует.
+	*/
+	inline int distance(int v, int w) const;
+
+	/*
+	 * Функция возвращает вершину, предшествующую вершине w на кратчайшем пути от
+	 * вершины v, либо -1, если пути не существует или v == w.
+	*/
+	inline int predecessor(int v, int w) const;
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция записывает кратчайший путь от вершины v до вершины w (номера вершин
+	 * v, k1, ..., kn, w) в буфер buf емкостью capacity (см. PathTracer).
+	 * ~~~~ Примечания:
+	 * Возвращает количество вершин пути, 0, если пути не существует, либо -1, если
+	 * путь не помещается в буфер. Память не выделяет.
+	*/
+	int path(int v, int w, int *buf, int capacity) const;
+
+	/*
+	 * Функция возвращает кратчайший путь от вершины v до вершины w в виде вектора
+	 * номеров вершин v, k1, ..., kn, w (пустой вектор, если пути не существует).
+	*/
+	vector<int> path(int v, int w) const;
+
+	/*
+	 * Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+	 * w и его стоимостью в формате: "v-k1-k2-...-kn-w, P" (см. ShortestPathSearcher).
+	*/
+	string get_path(int v, int w) const;
+
+	/*
+	 * Функция возвращает статистику последней операции: вычисления матриц,
+	 * обработки изменения графа или запроса (в режиме FLOYD - статистику
+	 * ShortestPathSearcher).
+	*/
+	inline const Stats &statistics() const;
+};
+
+#endif // _ALL_PAIRS_SEARCHER_
\ No newline at end of file
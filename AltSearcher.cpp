@@ -0,0 +1,378 @@
+#include "AltSearcher.hpp"
+
+// Вспомогательная функция поиска Дейкстры из вершины s в графе G. Записывает
+// расстояния в d, предков - в p, порядок окончательной обработки вершин - в
+// order (если соответствующие указатели не равны nullptr).
+template<typename Graph, typename Stats>
+void AltSearcher<Graph, Stats>::sssp(const CsrGraph &G, int s, vector<int> &d,
+		vector<int> *p, vector<int> *order)
+{
+	d.assign(v_cnt, INF_COST);
+	if(p)
+		p->assign(v_cnt, -1);
+	if(order)
+		order->clear();
+
+	heap.clear();
+	d[s] = 0;
+	heap.push(s, 0);
+	while(!heap.empty()) {
+		int u = heap.pop();
+		if(order)
+			order->push_back(u);
+		for(int i = G.first(u); i < G.last(u); ++i) {
+			int x = G.target(i), nd = d[u] + G.cost(i);
+			if(nd < d[x]) {
+				d[x] = nd;
+				if(p)
+					(*p)[x] = u;
+				heap.push(x, nd);
+			}
+		}
+	}
+}
+
+// Вспомогательная функция, возвращающая нижнюю оценку расстояния от v до t по
+// неравенству треугольника для каждого ориентира L:
+// d(v, t) >= d(L, t) - d(L, v) и d(v, t) >= d(v, L) - d(t, L).
+// Если по какому-либо ориентиру видно, что путь из v в t не существует (L
+// достижим из v, но не из t, либо v достижима из L, а t - нет), возвращается
+// INF_COST.
+template<typename Graph, typename Stats>
+int AltSearcher<Graph, Stats>::bound(int v, int t) const {
+	const int *fv = from_lm.data() + (size_t)v * k_cnt, *ft = from_lm.data() + (size_t)t * k_cnt;
+	const int *tv = to_lm.data() + (size_t)v * k_cnt, *tt = to_lm.data() + (size_t)t * k_cnt;
+	int res = 0, n = landmarks.size();
+	for(int l = 0; l < n; ++l) {
+		if(fv[l] < INF_COST) {
+			if(ft[l] == INF_COST)
+				return INF_COST;
+			res = max(res, ft[l] - fv[l]);
+		}
+		if(tt[l] < INF_COST) {
+			if(tv[l] == INF_COST)
+				return INF_COST;
+			res = max(res, tv[l] - tt[l]);
+		}
+	}
+	return res;
+}
+
+// Выбор ориентира FARTHEST: вершина с максимальным минимальным (по выбранным
+// ориентирам) значением d(L, v) + d(v, L). Вершины, не связанные путями ни с
+// одним ориентиром, выбираются в первую очередь - так ориентиры появляются во
+// всех компонентах графа. Первый ориентир - достижимая из вершины 0 вершина,
+// наиболее удаленная от нее (по поиску Дейкстры из вершины 0).
+template<typename Graph, typename Stats>
+int AltSearcher<Graph, Stats>::pick_farthest() {
+	if(landmarks.empty()) {
+		vector<int> d;
+		sssp(fwd, 0, d, nullptr, nullptr);
+		int far = 0;
+		for(int v = 1; v < v_cnt; ++v)
+			if(d[v] < INF_COST && d[v] > d[far])
+				far = v;
+		return far;
+	}
+
+	int n = landmarks.size(), best = -1;
+	long long best_score = -1;
+	for(int v = 0; v < v_cnt; ++v) {
+		if(find(landmarks.begin(), landmarks.end(), v) != landmarks.end())
+			continue;
+		long long score = (long long)INF_COST * 2;
+		for(int l = 0; l < n; ++l)
+			score = min(score, (long long)from_lm[(size_t)v * k_cnt + l] + to_lm[(size_t)v * k_cnt + l]);
+		if(score > best_score)
+			best = v, best_score = score;
+	}
+	return best;
+}
+
+// Выбор ориентира AVOID. Строится дерево кратчайших путей из случайной вершины r;
+// вес вершины v - разность d(r, v) и текущей нижней оценки этого расстояния, размер
+// вершины - сумма весов ее поддерева (ноль, если в поддереве уже есть ориентир).
+// Из корня выполняется спуск в потомка наибольшего размера; достигнутый лист
+// становится новым ориентиром. Если подходящую вершину найти не удалось,
+// используется выбор FARTHEST.
+template<typename Graph, typename Stats>
+int AltSearcher<Graph, Stats>::pick_avoid(mt19937 &rng) {
+	if(landmarks.empty())
+		return pick_farthest();
+
+	vector<int> d, p, order;
+	vector<long long> size(v_cnt);
+	vector<char> covered(v_cnt);
+	for(int attempt = 0; attempt < 4; ++attempt) {
+		int r = rng() % v_cnt;
+		sssp(fwd, r, d, &p, &order);
+
+		fill(size.begin(), size.end(), 0);
+		fill(covered.begin(), covered.end(), 0);
+		for(int L : landmarks)
+			covered[L] = 1;
+		// Накопление размеров поддеревьев в порядке, обратном порядку обработки:
+		for(int i = order.size() - 1; i >= 0; --i) {
+			int v = order[i];
+			int b = bound(r, v);
+			size[v] += d[v] - (b == INF_COST ? 0 : b);
+			if(covered[v])
+				size[v] = 0;
+			if(p[v] != -1) {
+				size[p[v]] += size[v];
+				covered[p[v]] |= covered[v];
+			}
+		}
+
+		// Построение списков потомков и спуск от корня:
+		vector<vector<int>> children(v_cnt);
+		for(int v : order)
+			if(p[v] != -1)
+				children[p[v]].push_back(v);
+		int v = r;
+		while(true) {
+			int next = -1;
+			for(int c : children[v])
+				if(size[c] > 0 && (next == -1 || size[c] > size[next]))
+					next = c;
+			if(next == -1)
+				break;
+			v = next;
+		}
+		if(!covered[v])
+			return v;
+	}
+	return pick_farthest();
+}
+
+// Вспомогательная функция вычисления таблиц расстояний. Для каждого выбранного
+// ориентира выполняются поиски Дейкстры в исходном и транспонированном графах.
+// Если удалось выбрать меньше K ориентиров (в том числе из-за остановки по
+// control), таблицы упаковываются заново.
+template<typename Graph, typename Stats>
+bool AltSearcher<Graph, Stats>::preprocess(int K, selection sel, SearchControl *control) {
+	k_cnt = max(0, min(K, v_cnt));
+	landmarks.clear();
+	from_lm.assign((size_t)v_cnt * k_cnt, INF_COST);
+	to_lm.assign((size_t)v_cnt * k_cnt, INF_COST);
+
+	mt19937 rng(v_cnt);
+	vector<int> d;
+	bool complete = true;
+	while((int)landmarks.size() < k_cnt) {
+		if(control && !control->poll()) {
+			complete = false;
+			break;
+		}
+		int L = (sel == AVOID ? pick_avoid(rng) : pick_farthest());
+		if(L == -1)
+			break;
+		int l = landmarks.size();
+		sssp(fwd, L, d, nullptr, nullptr);
+		for(int v = 0; v < v_cnt; ++v)
+			from_lm[(size_t)v * k_cnt + l] = d[v];
+		sssp(bwd, L, d, nullptr, nullptr);
+		for(int v = 0; v < v_cnt; ++v)
+			to_lm[(size_t)v * k_cnt + l] = d[v];
+		landmarks.push_back(L);
+	}
+
+	int n = landmarks.size();
+	if(n < k_cnt) {
+		for(int v = 0; v < v_cnt; ++v)
+			for(int l = 0; l < n; ++l) {
+				from_lm[(size_t)v * n + l] = from_lm[(size_t)v * k_cnt + l];
+				to_lm[(size_t)v * n + l] = to_lm[(size_t)v * k_cnt + l];
+			}
+		k_cnt = n;
+		from_lm.resize((size_t)v_cnt * n);
+		to_lm.resize((size_t)v_cnt * n);
+	}
+	heap.clear();
+	return complete;
+}
+
+// Вспомогательная функция сброса буферов поиска за O(|touched|).
+template<typename Graph, typename Stats>
+void AltSearcher<Graph, Stats>::reset() {
+	for(int u : touched) {
+		dist[u] = INF_COST;
+		parent[u] = -1;
+		h[u] = -1;
+	}
+	touched.clear();
+	heap.clear();
+	settled = 0;
+}
+
+// Конструктор. Строит прямой и транспонированный CSR-графы и вычисляет таблицы ориентиров.
+template<typename Graph, typename Stats>
+AltSearcher<Graph, Stats>::AltSearcher(const Graph &G, int K, selection sel, SearchControl *control) :
+	fwd(G), bwd(fwd.reversed()), v_cnt(G.V()), k_cnt(0), k_req(K), sel_req(sel),
+	dist(G.V(), INF_COST), parent(G.V(), -1), h(G.V(), -1), heap(G.V()), settled(0)
+{
+	preprocess(K, sel, control);
+}
+
+// Конструктор. Загружает таблицы ориентиров из файла filename либо вычисляет
+// их и сохраняет в этот файл. Неполные таблицы (вычисление прервано) не сохраняются.
+template<typename Graph, typename Stats>
+AltSearcher<Graph, Stats>::AltSearcher(const Graph &G, const string &filename, int K, selection sel,
+		SearchControl *control) :
+	fwd(G), bwd(fwd.reversed()), v_cnt(G.V()), k_cnt(0), k_req(K), sel_req(sel),
+	dist(G.V(), INF_COST), parent(G.V(), -1), h(G.V(), -1), heap(G.V()), settled(0)
+{
+	if(!load(filename) && preprocess(K, sel, control))
+		save(filename);
+}
+
+// Функция сохранения таблиц ориентиров в двоичный файл. Формат: сигнатура "ALT2",
+// V, E, запрошенное количество ориентиров и способ выбора (параметры конструктора),
+// количество выбранных ориентиров K, контрольная сумма графа, номера ориентиров,
+// таблица from_lm, таблица to_lm.
+template<typename Graph, typename Stats>
+bool AltSearcher<Graph, Stats>::save(const string &filename) const {
+	ofstream fout(filename, ios::binary);
+	if(!fout.is_open())
+		return false;
+
+	int header[5] = {v_cnt, fwd.E(), k_req, sel_req, k_cnt};
+	unsigned long long sum = fwd.checksum();
+	fout.write("ALT2", 4);
+	fout.write((const char *)header, sizeof(header));
+	fout.write((const char *)&sum, sizeof(sum));
+	fout.write((const char *)landmarks.data(), landmarks.size() * sizeof(int));
+	fout.write((const char *)from_lm.data(), from_lm.size() * sizeof(int));
+	fout.write((const char *)to_lm.data(), to_lm.size() * sizeof(int));
+	return fout.good();
+}
+
+// Функция загрузки таблиц ориентиров из двоичного файла (см. save()). Равенство
+// количества вершин и ребер не гарантирует, что граф тот же (стоимости дуг могли
+// измениться), поэтому сравнивается и контрольная сумма графа.
+template<typename Graph, typename Stats>
+bool AltSearcher<Graph, Stats>::load(const string &filename) {
+	ifstream fin(filename, ios::binary);
+	if(!fin.is_open())
+		return false;
+
+	char magic[4];
+	int header[5];
+	unsigned long long sum;
+	fin.read(magic, 4);
+	fin.read((char *)header, sizeof(header));
+	fin.read((char *)&sum, sizeof(sum));
+	if(!fin || string(magic, 4) != "ALT2" || header[0] != v_cnt || header[1] != fwd.E() ||
+			header[2] != k_req || header[3] != sel_req || header[4] < 0 || header[4] > v_cnt ||
+			sum != fwd.checksum())
+		return false;
+
+	int K = header[4];
+	vector<int> lm(K), from((size_t)v_cnt * K), to((size_t)v_cnt * K);
+	fin.read((char *)lm.data(), lm.size() * sizeof(int));
+	fin.read((char *)from.data(), from.size() * sizeof(int));
+	fin.read((char *)to.data(), to.size() * sizeof(int));
+	if(!fin)
+		return false;
+
+	k_cnt = K;
+	landmarks.swap(lm);
+	from_lm.swap(from);
+	to_lm.swap(to);
+	return true;
+}
+
+// Функция возвращает номера выбранных ориентиров.
+template<typename Graph, typename Stats>
+const vector<int> &AltSearcher<Graph, Stats>::get_landmarks() const { return landmarks; }
+
+// Вспомогательная функция поиска кратчайшего пути из вершины v в вершину w.
+// Поиск A*: приоритет вершины равен сумме стоимости найденного пути до нее и
+// нижней оценки расстояния до w. Оценки ALT согласованы, поэтому каждая вершина
+// обрабатывается не более одного раза, а поиск завершается при извлечении w.
+// Вершины, из которых w заведомо недостижима, в кучу не добавляются. Извлечение
+// вершины из кучи засчитывается как шаг control.
+template<typename Graph, typename Stats>
+int AltSearcher<Graph, Stats>::query(int v, int w, SearchControl *control) {
+	stats.begin(QueryStats::SETUP);
+	if(v < 0 || w < 0 || v >= v_cnt || w >= v_cnt)
+		return INF_COST;
+
+	reset();
+	dist[v] = 0;
+	h[v] = bound(v, w);
+	touched.push_back(v);
+	if(h[v] == INF_COST)
+		return INF_COST;
+
+	stats.begin(QueryStats::SEARCH);
+	heap.push(v, h[v]);
+	while(!heap.empty()) {
+		if(control && !control->step())
+			return INF_COST;
+		int u = heap.pop();
+		++settled;
+		stats.expand();
+		if(u == w)
+			return dist[w];
+
+		stats.scan(fwd.last(u) - fwd.first(u));
+		for(int i = fwd.first(u); i < fwd.last(u); ++i) {
+			int x = fwd.target(i), nd = dist[u] + fwd.cost(i);
+			if(nd >= dist[x])
+				continue;
+			if(h[x] == -1) {
+				h[x] = bound(x, w);
+				touched.push_back(x);
+			}
+			if(h[x] == INF_COST)
+				continue;
+			dist[x] = nd;
+			parent[x] = u;
+			heap.push(x, nd + h[x]);
+		}
+	}
+	return INF_COST;
+}
+
+// Функция возвращает стоимость кратчайшего пути из вершины v в вершину w.
+template<typename Graph, typename Stats>
+int AltSearcher<Graph, Stats>::distance(int v, int w, SearchControl *control) {
+	stats.reset();
+	int d = query(v, w, control);
+	stats.end();
+	return d;
+}
+
+// Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+// w и его стоимостью в формате: "v-k1-k2-...-kn-w, P".
+template<typename Graph, typename Stats>
+string AltSearcher<Graph, Stats>::get_path(int v, int w, SearchControl *control) {
+	stats.reset();
+	int d = query(v, w, control);
+	string res;
+	if(d == INF_COST) {
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(v, w);
+	}
+	else {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		vector<int> path;
+		PathTracer::from_predecessors([&](int u) { return parent[u]; }, v, w, path);
+		stats.path();
+		stats.allocate(path.size() * sizeof(int));
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(path, d);
+	}
+	stats.allocate(res.size());
+	stats.end();
+	return res;
+}
+
+// Функция возвращает количество вершин, окончательно обработанных последним поиском.
+template<typename Graph, typename Stats>
+int AltSearcher<Graph, Stats>::last_settled() const { return settled; }
+
+// Функция возвращает статистику последнего запроса.
+template<typename Graph, typename Stats>
+const Stats &AltSearcher<Graph, Stats>::statistics() const { return stats; }
\ No newline at end of file
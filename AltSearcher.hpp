@@ -0,0 +1,150 @@
+#ifndef _ALT_SEARCHER_
+#define _ALT_SEARCHER_
+
+#include "main_header.hpp"
+#include "PathTracer.hpp"
+#include "CsrGraph.hpp"
+#include "DaryHeap.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс поиска кратчайшего пути между парой вершин графа Graph
+ * алгоритмом A* с нижними оценками по ориентирам (ALT: A*, Landmarks, Triangle
+ * inequality).
+ * ~~~~ Примечания:
+ * При предварительной обработке выбирается K вершин-ориентиров L и для каждой
+ * вершины v вычисляются расстояния d(L, v) и d(v, L). По неравенству треугольника
+ * d(v, t) >= max(d(L, t) - d(L, v), d(v, L) - d(t, L)), и максимум этих оценок
+ * по всем ориентирам используется как эвристика A*, направляющая поиск к цели.
+ * Таблицы расстояний можно сохранить в файл и загрузить при следующем запуске
+ * (см. save(), load() и второй конструктор).
+ * Предварительную обработку и запросы можно прервать (см. SearchControl): при
+ * обработке условия остановки проверяются перед выбором каждого ориентира, и
+ * прерванная обработка оставляет уже вычисленные ориентиры (оценки остаются
+ * нижними, поэтому запросы корректны, но просматривают больше вершин), а таблицы
+ * в файл не сохраняются; в запросе шагом считается извлечение вершины из кучи, а
+ * прерванный запрос возвращает отсутствие пути.
+ * Stats - политика статистики запросов (см. NoStats, CountingStats): каждый запрос
+ * сбрасывает статистику и учитывает извлеченные из кучи вершины, просмотренные
+ * дуги, найденный путь и время этапов. Предварительная обработка не учитывается.
+ * Стоимости ребер графа должны быть неотрицательными. Экземпляр класса не
+ * предназначен для одновременного использования из нескольких потоков.
+*/
+template<typename Graph, typename Stats = NoStats>
+class AltSearcher {
+public:
+	/*
+	 * Способ выбора ориентиров: FARTHEST - очередной ориентир - вершина, наиболее
+	 * удаленная от уже выбранных; AVOID - вершина, лежащая в поддереве кратчайших
+	 * путей, для которого текущие оценки наиболее неточны (Goldberg, Werneck).
+	*/
+	enum selection { FARTHEST, AVOID };
+private:
+	CsrGraph fwd, bwd;
+	int v_cnt, k_cnt;
+	/* Параметры выбора ориентиров, переданные конструктору (проверяются при load()). */
+	int k_req;
+	selection sel_req;
+	vector<int> landmarks;
+	/*
+	 * Таблицы расстояний, хранящиеся по вершинам: from_lm[v * K + l] = d(L_l, v),
+	 * to_lm[v * K + l] = d(v, L_l). Отсутствие пути обозначается INF_COST.
+	*/
+	vector<int> from_lm, to_lm;
+
+	/* Переиспользуемые буферы поиска (см. DijkstraSearcher). */
+	vector<int> dist, parent, h;
+	vector<int> touched;
+	DaryHeap<4> heap;
+	int settled;
+
+	/* Статистика последнего запроса. */
+	Stats stats;
+
+	/*
+	 * Вспомогательная функция поиска Дейкстры из вершины s в графе G. Записывает
+	 * расстояния в d, а также предков в p и порядок обработки вершин в order,
+	 * если соответствующие указатели не равны nullptr.
+	*/
+	void sssp(const CsrGraph &G, int s, vector<int> &d, vector<int> *p, vector<int> *order);
+
+	/* Вспомогательная функция, возвращающая нижнюю оценку расстояния от v до t. */
+	inline int bound(int v, int t) const;
+
+	/*
+	 * Вспомогательные функции выбора очередного ориентира. Возвращают -1, если
+	 * новый ориентир выбрать невозможно.
+	*/
+	int pick_farthest();
+	int pick_avoid(mt19937 &rng);
+
+	/*
+	 * Вспомогательная функция вычисления таблиц расстояний для K ориентиров.
+	 * Возвращает false, если вычисление прервано по control.
+	*/
+	bool preprocess(int K, selection sel, SearchControl *control);
+
+	/* Вспомогательная функция сброса буферов поиска. */
+	void reset();
+
+	/* Вспомогательная функция поиска A* из v в w (см. distance()) без сброса статистики. */
+	int query(int v, int w, SearchControl *control);
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; K - количество ориентиров; sel - способ выбора ориентиров;
+	 * control - управление предварительной обработкой (nullptr - без ограничений).
+	*/
+	AltSearcher(const Graph &G, int K = 8, selection sel = AVOID, SearchControl *control = nullptr);
+
+	/*
+	 * Конструктор. Загружает таблицы ориентиров из файла filename; если файл
+	 * отсутствует или построен для другого графа, таблицы вычисляются заново и
+	 * сохраняются в этот файл (если вычисление не прервано по control).
+	*/
+	AltSearcher(const Graph &G, const string &filename, int K = 8, selection sel = AVOID,
+		SearchControl *control = nullptr);
+
+	/* Функция сохранения таблиц ориентиров в файл. Возвращает false при ошибке. */
+	bool save(const string &filename) const;
+
+	/*
+	 * Функция загрузки таблиц ориентиров из файла. Возвращает false, если файл не
+	 * удалось прочитать, он построен для другого графа (не совпадают количество
+	 * вершин, ребер или контрольная сумма CsrGraph::checksum()) либо с другими
+	 * количеством ориентиров или способом их выбора, чем заданы конструктору.
+	*/
+	bool load(const string &filename);
+
+	/* Функция возвращает номера выбранных ориентиров. */
+	inline const vector<int> &get_landmarks() const;
+
+	/*
+	 * Функция возвращает стоимость кратчайшего пути из вершины v в вершину w
+	 * либо INF_COST, если пути не существует или поиск прерван по control.
+	*/
+	int distance(int v, int w, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+	 * w и его стоимостью в формате: "v-k1-k2-...-kn-w, P" (см. ShortestPathSearcher).
+	 * Если пути не существует (или поиск прерван по control), возвращается строка
+	 * "v-w, inf".
+	*/
+	string get_path(int v, int w, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает количество вершин, окончательно обработанных последним
+	 * поиском. Для сравнения с обычным алгоритмом Дейкстры см.
+	 * DijkstraSearcher::last_settled().
+	*/
+	inline int last_settled() const;
+
+	/* Функция возвращает статистику последнего запроса. */
+	inline const Stats &statistics() const;
+};
+
+#endif // _ALT_SEARCHER_
\ No newline at end of file
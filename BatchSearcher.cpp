@@ -0,0 +1,201 @@
+#include "BatchSearcher.hpp"
+
+// Вспомогательная функция разбиения запросов на группы. Сначала подсчитывается,
+// сколько запросов пакета начинается в каждой вершине и сколько заканчивается;
+// запрос (v, w) относится к группе по w, если запросов, заканчивающихся в w,
+// больше, чем начинающихся в v. Запросы с недопустимыми номерами вершин в
+// группы не попадают.
+template<typename Graph, typename Stats>
+vector<typename BatchSearcher<Graph, Stats>::group> BatchSearcher<Graph, Stats>::make_groups(
+		const vector<pair<int, int>> &queries) const
+{
+	unordered_map<int, int> from_cnt, to_cnt;
+	for(auto &q : queries)
+		if(q.first >= 0 && q.second >= 0 && q.first < v_cnt && q.second < v_cnt) {
+			++from_cnt[q.first];
+			++to_cnt[q.second];
+		}
+
+	vector<group> groups;
+	unordered_map<long long, int> index;
+	for(int i = 0; i < (int)queries.size(); ++i) {
+		int v = queries[i].first, w = queries[i].second;
+		if(v < 0 || w < 0 || v >= v_cnt || w >= v_cnt)
+			continue;
+		bool reverse = to_cnt[w] > from_cnt[v];
+		int root = (reverse ? w : v);
+		auto it = index.emplace(2LL * root + reverse, groups.size());
+		if(it.second)
+			groups.push_back({root, reverse, {}});
+		groups[it.first->second].queries.push_back(i);
+	}
+
+	sort(groups.begin(), groups.end(), [](const group &a, const group &b) {
+		return a.queries.size() > b.queries.size();
+	});
+	return groups;
+}
+
+// Вспомогательная функция поиска для группы g. Вершины-цели группы помечаются
+// текущей меткой потока stamp; поиск Дейкстры завершается, когда извлечены все
+// помеченные вершины. В обратном графе предок вершины - следующая за ней вершина
+// на пути к корню, поэтому путь восстанавливается от v вперед.
+template<typename Graph, typename Stats>
+void BatchSearcher<Graph, Stats>::solve_group(const group &g, worker &W,
+		const vector<pair<int, int>> &queries, vector<int> &costs, vector<vector<int>> *paths)
+{
+	const CsrGraph &G = (g.reverse ? bwd : fwd);
+	int stamp = ++W.stamp, remaining = 0;
+	for(int i : g.queries) {
+		int t = (g.reverse ? queries[i].first : queries[i].second);
+		if(W.want[t] != stamp) {
+			W.want[t] = stamp;
+			++remaining;
+		}
+	}
+
+	W.dist[g.root] = 0;
+	W.touched.push_back(g.root);
+	W.heap.push(g.root, 0);
+	while(!W.heap.empty()) {
+		int u = W.heap.pop();
+		++W.expanded;
+		if(W.want[u] == stamp && --remaining == 0)
+			break;
+		W.scanned += G.last(u) - G.first(u);
+		for(int i = G.first(u); i < G.last(u); ++i) {
+			int x = G.target(i), d = W.dist[u] + G.cost(i);
+			if(d < W.dist[x]) {
+				if(W.dist[x] == INF_COST)
+					W.touched.push_back(x);
+				W.dist[x] = d;
+				W.parent[x] = u;
+				W.heap.push(x, d);
+			}
+		}
+	}
+
+	for(int i : g.queries) {
+		int v = queries[i].first, w = queries[i].second;
+		int d = W.dist[g.reverse ? v : w];
+		costs[i] = d;
+		if(!paths || d == INF_COST)
+			continue;
+		auto &path = (*paths)[i];
+		if(g.reverse)
+			for(int u = v; u != -1; u = (u == w ? -1 : W.parent[u]))
+				path.push_back(u);
+		else
+			PathTracer::from_predecessors([&](int u) { return W.parent[u]; }, v, w, path);
+		++W.found;
+		W.bytes += path.size() * sizeof(int);
+	}
+
+	for(int u : W.touched) {
+		W.dist[u] = INF_COST;
+		W.parent[u] = -1;
+	}
+	W.touched.clear();
+	W.heap.clear();
+}
+
+// Основная функция обработки пакета. Потоки берут группы по одной из общего
+// счетчика; группы упорядочены по убыванию размера, поэтому длинные поиски
+// начинаются первыми и нагрузка распределяется равномернее. Перед каждой группой
+// проверяется control; после остановки потоки не берут новых групп. Счетчики
+// потоков добавляются в статистику после завершения поиска.
+template<typename Graph, typename Stats>
+void BatchSearcher<Graph, Stats>::solve(const vector<pair<int, int>> &queries, vector<int> &costs,
+		vector<vector<int>> *paths, SearchControl *control)
+{
+	stats.begin(QueryStats::SETUP);
+	costs.assign(queries.size(), INF_COST);
+	if(paths)
+		paths->assign(queries.size(), vector<int>());
+	stats.allocate(costs.size() * sizeof(int));
+	vector<group> groups = make_groups(queries);
+	traversals = groups.size();
+	for(auto &W : workers)
+		W.expanded = W.scanned = W.found = W.bytes = 0;
+
+	stats.begin(QueryStats::SEARCH);
+	atomic<int> next_group(0);
+	pool.run([&](int t) {
+		for(int k = next_group++; k < (int)groups.size(); k = next_group++) {
+			if(control && !control->poll())
+				return;
+			solve_group(groups[k], workers[t], queries, costs, paths);
+		}
+	});
+	for(auto &W : workers) {
+		stats.expand(W.expanded);
+		stats.scan(W.scanned);
+		for(long long i = 0; i < W.found; ++i)
+			stats.path();
+		stats.allocate(W.bytes);
+	}
+}
+
+// Конструктор. Строит прямое и обратное CSR-представления графа и буферы потоков.
+template<typename Graph, typename Stats>
+BatchSearcher<Graph, Stats>::BatchSearcher(const Graph &G, int threads) :
+	fwd(G), bwd(fwd.reversed()), v_cnt(G.V()), traversals(0), pool(threads)
+{
+	workers.reserve(pool.size());
+	for(int t = 0; t < pool.size(); ++t)
+		workers.emplace_back(v_cnt);
+}
+
+// Функция возвращает стоимости кратчайших путей для запросов queries.
+template<typename Graph, typename Stats>
+vector<int> BatchSearcher<Graph, Stats>::distances(const vector<pair<int, int>> &queries,
+		SearchControl *control)
+{
+	stats.reset();
+	vector<int> costs;
+	solve(queries, costs, nullptr, control);
+	stats.end();
+	return costs;
+}
+
+// Функция возвращает кратчайшие пути для запросов queries.
+template<typename Graph, typename Stats>
+vector<vector<int>> BatchSearcher<Graph, Stats>::paths(const vector<pair<int, int>> &queries,
+		SearchControl *control)
+{
+	stats.reset();
+	vector<int> costs;
+	vector<vector<int>> res;
+	solve(queries, costs, &res, control);
+	stats.end();
+	return res;
+}
+
+// Функция возвращает строки с кратчайшими путями для запросов queries.
+template<typename Graph, typename Stats>
+vector<string> BatchSearcher<Graph, Stats>::get_paths(const vector<pair<int, int>> &queries,
+		SearchControl *control)
+{
+	stats.reset();
+	vector<int> costs;
+	vector<vector<int>> found;
+	solve(queries, costs, &found, control);
+
+	stats.begin(QueryStats::FORMATTING);
+	vector<string> res(queries.size());
+	for(size_t i = 0; i < queries.size(); ++i) {
+		res[i] = (costs[i] == INF_COST ? PathTracer::format(queries[i].first, queries[i].second) :
+			PathTracer::format(found[i], costs[i]));
+		stats.allocate(res[i].size());
+	}
+	stats.end();
+	return res;
+}
+
+// Функция возвращает количество поисков, выполненных для последнего пакета.
+template<typename Graph, typename Stats>
+int BatchSearcher<Graph, Stats>::last_traversals() const { return traversals; }
+
+// Функция возвращает статистику последнего пакета.
+template<typename Graph, typename Stats>
+const Stats &BatchSearcher<Graph, Stats>::statistics() const { return stats; }
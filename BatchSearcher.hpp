@@ -0,0 +1,116 @@
+#ifndef _BATCH_SEARCHER_
+#define _BATCH_SEARCHER_
+
+#include "main_header.hpp"
+#include "PathTracer.hpp"
+#include "CsrGraph.hpp"
+#include "DaryHeap.hpp"
+#include "ThreadPool.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс пакетной обработки запросов кратчайших путей в графе Graph:
+ * принимает вектор запросов (v, w) и возвращает ответы в том же порядке.
+ * ~~~~ Примечания:
+ * Запросы группируются: запросы с общей начальной вершиной v решаются одним поиском
+ * Дейкстры из v в исходном графе, запросы с общей конечной вершиной w - одним
+ * поиском из w в обратном графе. Каждый запрос относится к той из двух групп
+ * (по v или по w), в которую попадает больше запросов пакета. Поиск группы
+ * останавливается, как только окончательно обработаны все ее вершины-цели.
+ * Группы распределяются между потоками пула (крупные - первыми); у каждого потока
+ * свои буферы поиска, которые сбрасываются за O(количество затронутых вершин).
+ * Обработку пакета можно прервать (см. SearchControl): условия остановки
+ * проверяются перед поиском каждой группы. Запросы групп, поиск которых не
+ * выполнялся, получают ответ "пути не существует" (как строки, не вычисленные
+ * AllPairsSearcher).
+ * Stats - политика статистики (см. NoStats, CountingStats): каждый вызов
+ * distances(), paths() и get_paths() сбрасывает статистику и учитывает весь пакет:
+ * извлеченные из кучи вершины и просмотренные дуги (потоки считают их в своих
+ * буферах, суммы добавляются после поиска), найденные пути, память результатов и
+ * время этапов. Восстановление путей выполняется потоками и входит во время поиска.
+ * Стоимости ребер графа должны быть неотрицательными. Методы пакетной обработки
+ * не предназначены для одновременного вызова из нескольких потоков.
+*/
+template<typename Graph, typename Stats = NoStats>
+class BatchSearcher {
+private:
+	/* Группа запросов: поиск из вершины root (в обратном графе, если reverse == true). */
+	struct group {
+		int root;
+		bool reverse;
+		vector<int> queries;
+	};
+
+	/* Буферы поиска одного потока. */
+	struct worker {
+		DaryHeap<4> heap;
+		vector<int> dist, parent, touched, want;
+		int stamp;
+		/* Счетчики статистики потока за текущий пакет. */
+		long long expanded, scanned, found, bytes;
+		worker(int n) : heap(n), dist(n, INF_COST), parent(n, -1), want(n, 0), stamp(0),
+			expanded(0), scanned(0), found(0), bytes(0) { }
+	};
+
+	CsrGraph fwd, bwd;
+	int v_cnt, traversals;
+	ThreadPool pool;
+	vector<worker> workers;
+
+	/* Статистика последнего пакета. */
+	Stats stats;
+
+	/* Вспомогательная функция разбиения запросов пакета на группы. */
+	vector<group> make_groups(const vector<pair<int, int>> &queries) const;
+
+	/*
+	 * Вспомогательная функция выполнения поиска для группы g буферами потока W.
+	 * Записывает стоимости (и пути, если paths != nullptr) запросов группы.
+	*/
+	void solve_group(const group &g, worker &W, const vector<pair<int, int>> &queries,
+		vector<int> &costs, vector<vector<int>> *paths);
+
+	/*
+	 * Основная функция обработки пакета (control - управление обработкой, может быть
+	 * nullptr). Статистику не сбрасывает и этап не завершает.
+	*/
+	void solve(const vector<pair<int, int>> &queries, vector<int> &costs,
+		vector<vector<int>> *paths, SearchControl *control);
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; threads - количество потоков (0 - по количеству аппаратных потоков).
+	*/
+	BatchSearcher(const Graph &G, int threads = 0);
+
+	/*
+	 * Функция возвращает стоимости кратчайших путей для запросов queries (пар
+	 * (v, w)) в порядке запросов; INF_COST, если пути не существует (или группа
+	 * запроса не обработана из-за остановки по control; nullptr - без ограничений).
+	*/
+	vector<int> distances(const vector<pair<int, int>> &queries, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает кратчайшие пути для запросов queries в виде векторов
+	 * номеров вершин v, k1, ..., kn, w (пустой вектор, если пути не существует).
+	 * control - см. distances().
+	*/
+	vector<vector<int>> paths(const vector<pair<int, int>> &queries, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает строки с кратчайшими путями для запросов queries в формате
+	 * "v-k1-k2-...-kn-w, P" (см. ShortestPathSearcher). control - см. distances().
+	*/
+	vector<string> get_paths(const vector<pair<int, int>> &queries, SearchControl *control = nullptr);
+
+	/* Функция возвращает количество поисков, выполненных для последнего пакета. */
+	inline int last_traversals() const;
+
+	/* Функция возвращает статистику последнего пакета. */
+	inline const Stats &statistics() const;
+};
+
+#endif // _BATCH_SEARCHER_
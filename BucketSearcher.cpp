@@ -0,0 +1,198 @@
+#include "BucketSearcher.hpp"
+
+// Вспомогательная функция сброса буферов поиска. Сбрасываются только значения
+// вершин, затронутых последним поиском.
+template<typename Graph, typename Stats>
+void BucketSearcher<Graph, Stats>::reset() {
+	for(int u : touched) {
+		dist[u] = INF_COST;
+		parent[u] = -1;
+	}
+	touched.clear();
+	for(auto &b : buckets)
+		b.clear();
+	radix.clear();
+	last_source = last_target = -1;
+	settled = 0;
+}
+
+// Вспомогательная функция релаксации всех ребер, исходящих из вершины u.
+template<typename Graph, typename Stats>
+template<typename Push>
+void BucketSearcher<Graph, Stats>::relax(int u, const Push &push) {
+	stats.scan(G.last(u) - G.first(u));
+	for(int i = G.first(u); i < G.last(u); ++i) {
+		int x = G.target(i), d = dist[u] + G.cost(i);
+		if(d < dist[x]) {
+			if(dist[x] == INF_COST)
+				touched.push_back(x);
+			dist[x] = d;
+			parent[x] = u;
+			push(x, d);
+		}
+	}
+}
+
+// Поиск с очередью Дейла. Корзины просматриваются по возрастанию расстояния cur;
+// запись корзины устарела, если расстояние вершины с тех пор уменьшилось.
+// Вершина с данным расстоянием добавляется в очередь один раз, поэтому каждая
+// актуальная запись извлекается ровно один раз. Поиск заканчивается, когда в
+// очереди не остается записей. Перед просмотром каждой корзины проверяется control.
+template<typename Graph, typename Stats>
+bool BucketSearcher<Graph, Stats>::run_dial(int s, int t, SearchControl *control) {
+	int nb = buckets.size(), pending = 1;
+	buckets[0].push_back(s);
+	auto push = [&](int x, int d) {
+		buckets[d % nb].push_back(x);
+		++pending;
+	};
+	for(int cur = 0; pending > 0; ++cur) {
+		if(control && !control->step())
+			return false;
+		auto &b = buckets[cur % nb];
+		// Ребра нулевой стоимости добавляют вершины в текущую корзину, поэтому
+		// корзина перечитывается, пока не опустеет.
+		while(!b.empty()) {
+			int u = b.back();
+			b.pop_back();
+			--pending;
+			if(dist[u] != cur)
+				continue;
+			++settled;
+			stats.expand();
+			if(u == t)
+				return true;
+			relax(u, push);
+		}
+	}
+	return true;
+}
+
+// Поиск с радиксной кучей. Устаревшие записи отбрасываются при извлечении;
+// control проверяется при извлечении каждой записи.
+template<typename Graph, typename Stats>
+bool BucketSearcher<Graph, Stats>::run_radix(int s, int t, SearchControl *control) {
+	radix.push(s, 0);
+	auto push = [&](int x, int d) { radix.push(x, d); };
+	while(!radix.empty()) {
+		if(control && !control->step())
+			return false;
+		int u = radix.pop();
+		if((unsigned)dist[u] != radix.last_key())
+			continue;
+		++settled;
+		stats.expand();
+		if(u == t)
+			return true;
+		relax(u, push);
+	}
+	return true;
+}
+
+// Конструктор. Строит CSR-представление графа, определяет максимальную стоимость
+// ребра и выбирает тип очереди.
+template<typename Graph, typename Stats>
+BucketSearcher<Graph, Stats>::BucketSearcher(const Graph &graph, queue q) :
+	G(graph), v_cnt(graph.V()), max_cost(0), used(q),
+	dist(graph.V(), INF_COST), parent(graph.V(), -1),
+	last_source(-1), last_target(-1), settled(0)
+{
+	for(int i = 0; i < G.E(); ++i)
+		max_cost = max(max_cost, G.cost(i));
+	if(used == AUTO)
+		used = (max_cost <= DIAL_MAX_COST ? DIAL : RADIX);
+	if(used == DIAL)
+		buckets.resize(max_cost + 1);
+}
+
+// Функция возвращает используемый тип очереди.
+template<typename Graph, typename Stats>
+typename BucketSearcher<Graph, Stats>::queue BucketSearcher<Graph, Stats>::kind() const { return used; }
+
+// Вспомогательная функция поиска из вершины s (до извлечения вершины t, если
+// t != -1). Прерванный поиск не запоминается как последний, поэтому distance() его
+// не использует.
+template<typename Graph, typename Stats>
+bool BucketSearcher<Graph, Stats>::search(int s, int t, SearchControl *control) {
+	stats.begin(QueryStats::SEARCH);
+	reset();
+	if(s < 0 || s >= v_cnt)
+		return true;
+	dist[s] = 0;
+	touched.push_back(s);
+	if(!(used == DIAL ? run_dial(s, t, control) : run_radix(s, t, control)))
+		return false;
+	last_source = s, last_target = t;
+	return true;
+}
+
+// Функция поиска из вершины s.
+template<typename Graph, typename Stats>
+bool BucketSearcher<Graph, Stats>::run(int s, int t, SearchControl *control) {
+	stats.reset();
+	bool complete = search(s, t, control);
+	stats.end();
+	return complete;
+}
+
+// Функции возвращают расстояния и предков, вычисленные последним поиском.
+template<typename Graph, typename Stats>
+const vector<int> &BucketSearcher<Graph, Stats>::distances() const { return dist; }
+
+template<typename Graph, typename Stats>
+const vector<int> &BucketSearcher<Graph, Stats>::parents() const { return parent; }
+
+// Вспомогательная функция, возвращающая стоимость кратчайшего пути из вершины v в
+// вершину w. Поиск не повторяется, если буферы уже содержат результат для этого
+// запроса (полное дерево из v или поиск из v, остановленный на w).
+template<typename Graph, typename Stats>
+int BucketSearcher<Graph, Stats>::query(int v, int w, SearchControl *control) {
+	stats.begin(QueryStats::SETUP);
+	if(v < 0 || w < 0 || v >= v_cnt || w >= v_cnt)
+		return INF_COST;
+	if((last_source != v || (last_target != -1 && last_target != w)) && !search(v, w, control))
+		return INF_COST;
+	return dist[w];
+}
+
+// Функция возвращает стоимость кратчайшего пути из вершины v в вершину w.
+template<typename Graph, typename Stats>
+int BucketSearcher<Graph, Stats>::distance(int v, int w, SearchControl *control) {
+	stats.reset();
+	int d = query(v, w, control);
+	stats.end();
+	return d;
+}
+
+// Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+// w и его стоимостью в формате: "v-k1-k2-...-kn-w, P".
+template<typename Graph, typename Stats>
+string BucketSearcher<Graph, Stats>::get_path(int v, int w, SearchControl *control) {
+	stats.reset();
+	int d = query(v, w, control);
+	string res;
+	if(d == INF_COST) {
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(v, w);
+	}
+	else {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		vector<int> path;
+		PathTracer::from_predecessors([&](int u) { return parent[u]; }, v, w, path);
+		stats.path();
+		stats.allocate(path.size() * sizeof(int));
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(path, d);
+	}
+	stats.allocate(res.size());
+	stats.end();
+	return res;
+}
+
+// Функция возвращает количество вершин, окончательно обработанных последним поиском.
+template<typename Graph, typename Stats>
+int BucketSearcher<Graph, Stats>::last_settled() const { return settled; }
+
+// Функция возвращает статистику последнего запроса.
+template<typename Graph, typename Stats>
+const Stats &BucketSearcher<Graph, Stats>::statistics() const { return stats; }
@@ -0,0 +1,124 @@
+#ifndef _BUCKET_SEARCHER_
+#define _BUCKET_SEARCHER_
+
+#include "main_header.hpp"
+#include "PathTracer.hpp"
+#include "CsrGraph.hpp"
+#include "RadixHeap.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс поиска кратчайших путей в графе Graph с целыми положительными
+ * стоимостями ребер алгоритмом Дейкстры, в котором куча заменена очередью из
+ * корзин.
+ * ~~~~ Примечания:
+ * Используется одна из двух очередей, выбираемая по максимальной стоимости ребра C
+ * при создании экземпляра:
+ * 1) очередь Дейла (Dial) - циклический массив из C + 1 корзин, корзина d % (C + 1)
+ * содержит вершины с оценкой расстояния d; все оценки в очереди лежат в пределах C
+ * от текущего минимума, поэтому корзины не пересекаются. Время поиска O(E + V * C);
+ * 2) радиксная куча (см. RadixHeap) для больших C - O(E + V * log C).
+ * Как и в DijkstraSearcher, буферы поиска переиспользуются между запросами и
+ * сбрасываются за время, пропорциональное количеству затронутых вершин, а поиск
+ * для пары вершин останавливается при извлечении конечной вершины.
+ * Поиск можно прервать (см. SearchControl): шагом считается корзина очереди Дейла
+ * либо извлечение вершины из радиксной кучи. Прерванный поиск не сохраняется в
+ * буферах (следующий запрос выполняет поиск заново), а запрос возвращает
+ * отсутствие пути.
+ * Stats - политика статистики запросов (см. NoStats, CountingStats): каждый вызов
+ * run(), distance() и get_path() сбрасывает статистику и учитывает извлеченные
+ * вершины, просмотренные дуги, найденный путь и время этапов запроса.
+ * Стоимости ребер графа должны быть неотрицательными.
+*/
+template<typename Graph, typename Stats = NoStats>
+class BucketSearcher {
+public:
+	/* Тип очереди: AUTO - выбор по максимальной стоимости ребра. */
+	enum queue { AUTO, DIAL, RADIX };
+private:
+	/* Максимальная стоимость ребра, при которой в режиме AUTO выбирается очередь Дейла. */
+	static const int DIAL_MAX_COST = 1024;
+
+	CsrGraph G;
+	int v_cnt, max_cost;
+	queue used;
+
+	/* Переиспользуемые буферы поиска (см. DijkstraSearcher). */
+	vector<int> dist, parent, touched;
+	/* Корзины очереди Дейла. */
+	vector<vector<int>> buckets;
+	RadixHeap radix;
+	int last_source, last_target, settled;
+
+	/* Статистика последнего запроса. */
+	Stats stats;
+
+	/* Вспомогательная функция сброса буферов поиска за O(|touched|). */
+	void reset();
+
+	/* Вспомогательная функция релаксации ребер вершины u; push(x, d) добавляет вершину в очередь. */
+	template<typename Push>
+	inline void relax(int u, const Push &push);
+
+	/*
+	 * Вспомогательные функции поиска из вершины s с очередью Дейла и радиксной кучей.
+	 * Возвращают false, если поиск прерван по control.
+	*/
+	bool run_dial(int s, int t, SearchControl *control);
+	bool run_radix(int s, int t, SearchControl *control);
+
+	/* Вспомогательная функция поиска из вершины s (см. run()) без сброса статистики. */
+	bool search(int s, int t, SearchControl *control);
+
+	/* Вспомогательная функция ответа на запрос (v, w) (см. distance()) без сброса статистики. */
+	int query(int v, int w, SearchControl *control);
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; q - тип очереди (AUTO - очередь Дейла, если максимальная стоимость
+	 * ребра не больше DIAL_MAX_COST, иначе радиксная куча).
+	*/
+	BucketSearcher(const Graph &G, queue q = AUTO);
+
+	/* Функция возвращает используемый тип очереди (DIAL или RADIX). */
+	inline queue kind() const;
+
+	/*
+	 * Функция поиска из вершины s. Если t != -1, поиск останавливается после
+	 * извлечения вершины t, иначе строится полное дерево кратчайших путей.
+	 * Возвращает false, если поиск прерван по control (nullptr - без ограничений).
+	*/
+	bool run(int s, int t = -1, SearchControl *control = nullptr);
+
+	/*
+	 * Функции возвращают расстояния и предков, вычисленные последним вызовом run()
+	 * (окончательны только для вершин, извлеченных до остановки поиска).
+	*/
+	inline const vector<int> &distances() const;
+	inline const vector<int> &parents() const;
+
+	/*
+	 * Функция возвращает стоимость кратчайшего пути из вершины v в вершину w
+	 * либо INF_COST, если пути не существует или поиск прерван по control.
+	*/
+	int distance(int v, int w, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+	 * w и его стоимостью в формате: "v-k1-k2-...-kn-w, P" (см. ShortestPathSearcher).
+	 * Если пути не существует (или поиск прерван по control), возвращается строка
+	 * "v-w, inf".
+	*/
+	string get_path(int v, int w, SearchControl *control = nullptr);
+
+	/* Функция возвращает количество вершин, окончательно обработанных последним поиском. */
+	inline int last_settled() const;
+
+	/* Функция возвращает статистику последнего вызова run(), distance() или get_path(). */
+	inline const Stats &statistics() const;
+};
+
+#endif // _BUCKET_SEARCHER_
@@ -0,0 +1,120 @@
+#include "ConcurrentGraphBuilder.hpp"
+
+// Конструктор.
+ConcurrentGraphBuilder::ConcurrentGraphBuilder(int V, bool _directed, int slot_cnt) :
+	v_cnt(V), _directed(_directed), slots(max(slot_cnt, 1)) { }
+
+// Функция возвращает количество вершин в графе.
+int ConcurrentGraphBuilder::V() const { return v_cnt; }
+
+// Функция возвращает количество слотов.
+int ConcurrentGraphBuilder::size() const { return slots.size(); }
+
+// Функция добавления ребра в слот.
+void ConcurrentGraphBuilder::insert(int slot, int v, int w, int c) { slots[slot].push_back(Edge(v, w, c)); }
+
+void ConcurrentGraphBuilder::insert(int slot, Edge e) { slots[slot].push_back(e); }
+
+// Функция возвращает количество добавленных ребер.
+long long ConcurrentGraphBuilder::edges() const {
+	long long n = 0;
+	for(auto &s : slots)
+		n += s.size();
+	return n;
+}
+
+// Функция построения графа. Слоты рассматриваются как одна последовательность
+// ребер, которая делится между потоками на равные части:
+// 1) каждый поток подсчитывает дуги своей части по начальным вершинам (ребро
+//    неориентированного графа порождает две дуги, петля - одну);
+// 2) по счетчикам вычисляются границы списков и позиции записи каждого потока в
+//    каждом списке: части потоков записываются в список друг за другом по порядку;
+// 3) каждый поток раскладывает дуги своей части по спискам; внутри списка дуги
+//    остаются в порядке добавления ребер;
+// 4) каждый список устойчиво сортируется по конечной вершине, из повторяющихся дуг
+//    остается первая. Обе дуги ребра (v, w) занимают в своих списках позицию этого
+//    ребра, поэтому в обоих направлениях сохраняется стоимость первого из ребер
+//    (v, w), (w, v), как при последовательном вызове SparseGraph::insert();
+// 5) списки без повторов копируются в итоговые векторы графа.
+CsrGraph ConcurrentGraphBuilder::build(int threads) const {
+	ThreadPool pool(threads);
+	int T = pool.size();
+	vector<long long> slot_start(slots.size() + 1, 0);
+	for(size_t s = 0; s < slots.size(); ++s)
+		slot_start[s + 1] = slot_start[s] + slots[s].size();
+	long long n = slot_start.back();
+
+	auto valid = [this](const Edge &e) {
+		return e.v >= 0 && e.w >= 0 && e.v < v_cnt && e.w < v_cnt;
+	};
+	// Обход ребер части потока t по порядку с вызовом f для каждого корректного ребра.
+	auto for_part = [&](int t, const function<void(const Edge &)> &f) {
+		long long k = n * t / T, stop = n * (t + 1) / T;
+		int s = upper_bound(slot_start.begin(), slot_start.end(), k) - slot_start.begin() - 1;
+		for(; k < stop; ++k) {
+			while(k >= slot_start[s + 1])
+				++s;
+			const Edge &e = slots[s][k - slot_start[s]];
+			if(valid(e))
+				f(e);
+		}
+	};
+
+	vector<vector<long long>> pos(T, vector<long long>(v_cnt, 0));
+	pool.run([&](int t) {
+		auto &cnt = pos[t];
+		for_part(t, [&](const Edge &e) {
+			++cnt[e.v];
+			if(!_directed && e.v != e.w)
+				++cnt[e.w];
+		});
+	});
+
+	vector<long long> start(v_cnt + 1, 0);
+	for(int v = 0; v < v_cnt; ++v) {
+		start[v + 1] = start[v];
+		for(int t = 0; t < T; ++t) {
+			long long c = pos[t][v];
+			pos[t][v] = start[v + 1];
+			start[v + 1] += c;
+		}
+	}
+
+	vector<pair<int, int>> arcs(start[v_cnt]);
+	pool.run([&](int t) {
+		auto &p = pos[t];
+		for_part(t, [&](const Edge &e) {
+			arcs[p[e.v]++] = {e.w, e.c};
+			if(!_directed && e.v != e.w)
+				arcs[p[e.w]++] = {e.v, e.c};
+		});
+	});
+
+	vector<int> kept(v_cnt + 1, 0);
+	pool.run([&](int t) {
+		for(int v = (long long)v_cnt * t / T; v < (long long)v_cnt * (t + 1) / T; ++v) {
+			auto b = arcs.begin() + start[v], e = arcs.begin() + start[v + 1];
+			stable_sort(b, e, [](const pair<int, int> &x, const pair<int, int> &y) {
+				return x.first < y.first;
+			});
+			kept[v + 1] = unique(b, e, [](const pair<int, int> &x, const pair<int, int> &y) {
+				return x.first == y.first;
+			}) - b;
+		}
+	});
+	for(int v = 0; v < v_cnt; ++v)
+		kept[v + 1] += kept[v];
+
+	CsrGraph G(v_cnt, vector<Edge>(), _directed);
+	G.offsets = kept;
+	G.targets.resize(kept[v_cnt]);
+	G.costs.resize(kept[v_cnt]);
+	pool.run([&](int t) {
+		for(int v = (long long)v_cnt * t / T; v < (long long)v_cnt * (t + 1) / T; ++v)
+			for(int i = kept[v]; i < kept[v + 1]; ++i) {
+				G.targets[i] = arcs[start[v] + i - kept[v]].first;
+				G.costs[i] = arcs[start[v] + i - kept[v]].second;
+			}
+	});
+	return G;
+}
@@ -0,0 +1,69 @@
+#ifndef _CONCURRENT_GRAPH_BUILDER_
+#define _CONCURRENT_GRAPH_BUILDER_
+
+#include "main_header.hpp"
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Построитель графа, в который ребра добавляются из нескольких потоков
+ * одновременно; результат строится в CSR-представлении (CsrGraph) параллельной
+ * сортировкой подсчетом.
+ * ~~~~ Примечания:
+ * Ребра накапливаются в буферах (слотах): каждый поток добавляет ребра в свой
+ * слот, поэтому добавление не требует синхронизации и выполняется за O(1).
+ * Итоговый граф совпадает с графом, полученным последовательным вызовом
+ * SparseGraph::insert() для всех ребер в порядке слотов (слот 0, затем слот 1 и
+ * т.д.), а внутри слота - в порядке добавления. Поэтому, если поток t разбирает
+ * t-ю часть входных данных и добавляет ребра в слот t, граф совпадает с графом,
+ * построенным последовательным разбором. Как и в SparseGraph::insert(), из
+ * повторяющихся дуг сохраняется первая, а в неориентированном графе ребро (v, w)
+ * добавляет дуги (v, w) и (w, v) стоимостью первого из ребер (v, w), (w, v).
+ * Ребра с некорректными номерами вершин пропускаются.
+*/
+class ConcurrentGraphBuilder {
+private:
+	int v_cnt;
+	bool _directed;
+	vector<vector<Edge>> slots;
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * V - количество вершин; _directed - признак ориентированности графа;
+	 * slot_cnt - количество слотов (обычно равно количеству добавляющих потоков).
+	*/
+	ConcurrentGraphBuilder(int V, bool _directed = true, int slot_cnt = 1);
+
+	/* Функция возвращает количество вершин в графе. */
+	inline int V() const;
+
+	/* Функция возвращает количество слотов. */
+	inline int size() const;
+
+	/*
+	 * Функция добавления в слот slot ребра из вершины v в вершину w стоимостью c.
+	 * Разные слоты можно заполнять из разных потоков одновременно; один слот -
+	 * только из одного потока в каждый момент времени.
+	*/
+	inline void insert(int slot, int v, int w, int c);
+
+	/* Функция добавления ребра e в слот slot (см. insert(int, int, int, int)). */
+	inline void insert(int slot, Edge e);
+
+	/* Функция возвращает количество добавленных ребер. */
+	long long edges() const;
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция построения графа по добавленным ребрам в threads потоках (0 - по
+	 * количеству аппаратных потоков).
+	 * ~~~~ Примечания:
+	 * Добавленные ребра сохраняются, поэтому после добавления новых ребер граф
+	 * можно построить заново. Во время построения ребра добавлять нельзя.
+	*/
+	CsrGraph build(int threads = 0) const;
+};
+
+#endif // _CONCURRENT_GRAPH_BUILDER_
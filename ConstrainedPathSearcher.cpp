@@ -0,0 +1,188 @@
+#include "ConstrainedPathSearcher.hpp"
+
+// Вспомогательная функция сброса. Емкость пула и множеств меток сохраняется,
+// поэтому повторные запросы не выделяют память заново.
+template<typename Graph, typename Stats>
+void ConstrainedPathSearcher<Graph, Stats>::reset() {
+	for(int x : touched)
+		bag[x].clear();
+	touched.clear();
+	pool.clear();
+	while(!queue.empty())
+		queue.pop();
+}
+
+// Вспомогательная функция проверки подчиненности: пара (c, r) подчинена, если в
+// вершине x есть метка, не худшая по обеим компонентам.
+template<typename Graph, typename Stats>
+bool ConstrainedPathSearcher<Graph, Stats>::dominated(int x, int c, int r) const {
+	for(int id : bag[x])
+		if(pool[id].cost <= c && pool[id].res <= r)
+			return true;
+	return false;
+}
+
+// Вспомогательная функция добавления метки. Подчиненная метка не добавляется;
+// метки вершины x, подчиненные новой, исключаются из множества и помечаются
+// неактуальными (в очереди они пропускаются).
+template<typename Graph, typename Stats>
+void ConstrainedPathSearcher<Graph, Stats>::add(int x, int c, int r, int prev) {
+	auto &b = bag[x];
+	if(dominated(x, c, r))
+		return;
+	if(b.empty())
+		touched.push_back(x);
+	for(size_t k = 0; k < b.size(); )
+		if(c <= pool[b[k]].cost && r <= pool[b[k]].res) {
+			pool[b[k]].alive = false;
+			b[k] = b.back();
+			b.pop_back();
+		} else
+			++k;
+
+	int id = pool.size();
+	pool.push_back({c, r, x, prev, true});
+	b.push_back(id);
+	queue.emplace(c, r, id);
+}
+
+// Основная функция поиска. Метки извлекаются в порядке возрастания (стоимость,
+// ресурс), поэтому первая извлеченная метка вершины w - оптимальный путь. При
+// построении фронта метки, подчиненные уже найденным меткам w, не продолжаются:
+// стоимости и ресурсы неотрицательны, и их продолжения были бы подчинены тоже.
+template<typename Graph, typename Stats>
+int ConstrainedPathSearcher<Graph, Stats>::solve(int v, int w, int budget, bool all,
+		SearchControl *control)
+{
+	stats.begin(QueryStats::SEARCH);
+	reset();
+	if(v < 0 || w < 0 || v >= v_cnt || w >= v_cnt || budget < 0)
+		return -1;
+
+	add(v, 0, 0, -1);
+	while(!queue.empty()) {
+		if(control && !control->step())
+			return -1;
+		int c, r, id;
+		tie(c, r, id) = queue.top();
+		queue.pop();
+		if(!pool[id].alive)
+			continue;
+		int u = pool[id].v;
+		stats.expand();
+		if(u == w) {
+			if(!all)
+				return id;
+			continue;
+		}
+		if(all && dominated(w, c, r))
+			continue;
+
+		stats.scan(G.last(u) - G.first(u));
+		for(int i = G.first(u); i < G.last(u); ++i)
+			if(res[i] <= budget - r)
+				add(G.target(i), c + G.cost(i), r + res[i], id);
+	}
+	return -1;
+}
+
+// Вспомогательная функция восстановления пути: цепочка меток проходится от
+// последней вершины к первой, затем порядок вершин обращается.
+template<typename Graph, typename Stats>
+vector<int> ConstrainedPathSearcher<Graph, Stats>::trace(int id) {
+	stats.begin(QueryStats::RECONSTRUCTION);
+	vector<int> path;
+	for(; id != -1; id = pool[id].prev)
+		path.push_back(pool[id].v);
+	reverse(path.begin(), path.end());
+	stats.path();
+	stats.allocate(path.size() * sizeof(int));
+	return path;
+}
+
+// Конструктор. Ресурс каждой дуги равен 1.
+template<typename Graph, typename Stats>
+ConstrainedPathSearcher<Graph, Stats>::ConstrainedPathSearcher(const Graph &graph) :
+	G(graph), v_cnt(graph.V()), res(G.E(), 1), bag(graph.V()) { }
+
+// Конструктор. Ресурсы дуг вычисляются функцией resource один раз.
+template<typename Graph, typename Stats>
+ConstrainedPathSearcher<Graph, Stats>::ConstrainedPathSearcher(const Graph &graph,
+		const function<int(int, int, int)> &resource) :
+	G(graph), v_cnt(graph.V()), bag(graph.V())
+{
+	res.reserve(G.E());
+	for(int v = 0; v < v_cnt; ++v)
+		for(int i = G.first(v); i < G.last(v); ++i)
+			res.push_back(resource(v, G.target(i), G.cost(i)));
+}
+
+// Функция возвращает стоимость кратчайшего пути с ресурсом не больше budget.
+template<typename Graph, typename Stats>
+int ConstrainedPathSearcher<Graph, Stats>::distance(int v, int w, int budget, SearchControl *control) {
+	stats.reset();
+	stats.begin(QueryStats::SETUP);
+	int id = solve(v, w, budget, false, control);
+	stats.end();
+	return (id == -1 ? INF_COST : pool[id].cost);
+}
+
+// Функция возвращает кратчайший путь с ресурсом не больше budget.
+template<typename Graph, typename Stats>
+vector<int> ConstrainedPathSearcher<Graph, Stats>::path(int v, int w, int budget,
+		SearchControl *control)
+{
+	stats.reset();
+	stats.begin(QueryStats::SETUP);
+	int id = solve(v, w, budget, false, control);
+	vector<int> res = (id == -1 ? vector<int>() : trace(id));
+	stats.end();
+	return res;
+}
+
+// Функция возвращает строку с кратчайшим путем с ресурсом не больше budget.
+template<typename Graph, typename Stats>
+string ConstrainedPathSearcher<Graph, Stats>::get_path(int v, int w, int budget,
+		SearchControl *control)
+{
+	stats.reset();
+	stats.begin(QueryStats::SETUP);
+	int id = solve(v, w, budget, false, control);
+	vector<int> path;
+	if(id != -1)
+		path = trace(id);
+	stats.begin(QueryStats::FORMATTING);
+	string res = (id == -1 ? PathTracer::format(v, w) : PathTracer::format(path, pool[id].cost));
+	stats.allocate(res.size());
+	stats.end();
+	return res;
+}
+
+// Функция возвращает Парето-фронт путей из v в w: множество неподчиненных меток
+// вершины w после полного поиска.
+template<typename Graph, typename Stats>
+vector<typename ConstrainedPathSearcher<Graph, Stats>::result> ConstrainedPathSearcher<Graph, Stats>::pareto(
+		int v, int w, int budget, SearchControl *control)
+{
+	vector<result> front;
+	stats.reset();
+	stats.begin(QueryStats::SETUP);
+	solve(v, w, budget, true, control);
+	if(v >= 0 && w >= 0 && v < v_cnt && w < v_cnt) {
+		for(int id : bag[w])
+			front.push_back({pool[id].cost, pool[id].res, trace(id)});
+		sort(front.begin(), front.end(), [](const result &a, const result &b) {
+			return a.cost < b.cost || (a.cost == b.cost && a.resource < b.resource);
+		});
+	}
+	stats.end();
+	return front;
+}
+
+// Функция возвращает количество меток, созданных последним поиском.
+template<typename Graph, typename Stats>
+int ConstrainedPathSearcher<Graph, Stats>::last_labels() const { return pool.size(); }
+
+// Функция возвращает статистику последнего запроса.
+template<typename Graph, typename Stats>
+const Stats &ConstrainedPathSearcher<Graph, Stats>::statistics() const { return stats; }
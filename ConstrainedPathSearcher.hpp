@@ -0,0 +1,138 @@
+#ifndef _CONSTRAINED_PATH_SEARCHER_
+#define _CONSTRAINED_PATH_SEARCHER_
+
+#include "main_header.hpp"
+#include "CsrGraph.hpp"
+#include "PathTracer.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс поиска кратчайших путей с ограничением на второй ресурс
+ * (resource-constrained shortest path) в графе Graph: находит путь минимальной
+ * стоимости из v в w, суммарный ресурс дуг которого не превышает бюджета, а также
+ * Парето-фронт путей по паре (стоимость, ресурс).
+ * ~~~~ Примечания:
+ * Ресурс дуги задается функцией resource(v, w, c) при построении (по умолчанию
+ * каждая дуга расходует единицу ресурса, то есть ограничивается количество дуг
+ * пути). Используется алгоритм установки меток: метка - пара (стоимость, ресурс)
+ * пути из v в вершину; метки извлекаются из очереди в лексикографическом порядке
+ * пар. В каждой вершине хранится множество неподчиненных меток: метка, не лучшая
+ * ни по одной компоненте, чем одна из имеющихся, отбрасывается, а подчиненные ей
+ * метки исключаются. Метки размещаются в общем пуле, который переиспользуется
+ * между запросами; исключенные метки остаются в пуле, так как на них могут
+ * ссылаться другие метки как на предыдущую вершину пути.
+ * Запрос можно прервать (см. SearchControl): извлечение метки из очереди
+ * засчитывается как шаг. Прерванный поиск пути возвращает отсутствие пути,
+ * прерванное построение Парето-фронта - неподчиненные пути, найденные до
+ * остановки (фронт может быть неполным и неточным).
+ * Stats - политика статистики запросов (см. NoStats, CountingStats): каждый запрос
+ * сбрасывает статистику и учитывает извлеченные актуальные метки (раскрытия),
+ * просмотренные дуги, найденные пути и время этапов.
+ * Стоимости и ресурсы дуг должны быть неотрицательными. Экземпляр не
+ * предназначен для одновременного использования из нескольких потоков.
+*/
+template<typename Graph, typename Stats = NoStats>
+class ConstrainedPathSearcher {
+public:
+	/* Путь Парето-фронта: стоимость, суммарный ресурс и вершины v, k1, ..., kn, w. */
+	struct result {
+		int cost, resource;
+		vector<int> path;
+	};
+private:
+	/* Метка: стоимость и ресурс пути в вершину v; prev - метка предыдущей вершины пути. */
+	struct label {
+		int cost, res, v, prev;
+		bool alive;
+	};
+
+	CsrGraph G;
+	int v_cnt;
+	/* res[i] - ресурс дуги с индексом i в G. */
+	vector<int> res;
+
+	/* Пул меток и множества неподчиненных меток вершин (индексы в пуле). */
+	vector<label> pool;
+	vector<vector<int>> bag;
+	/* Вершины с непустыми множествами меток (для сброса за O(|touched|)). */
+	vector<int> touched;
+	priority_queue<tuple<int, int, int>, vector<tuple<int, int, int>>,
+		greater<tuple<int, int, int>>> queue;
+
+	/* Статистика последнего запроса. */
+	Stats stats;
+
+	/* Вспомогательная функция сброса пула, множеств меток и очереди. */
+	void reset();
+
+	/* Вспомогательная функция проверки подчиненности пары (c, r) меткам вершины x. */
+	bool dominated(int x, int c, int r) const;
+
+	/* Вспомогательная функция добавления метки (c, r) вершины x с предыдущей меткой prev. */
+	void add(int x, int c, int r, int prev);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Основная функция поиска меток путей из v в w с ресурсом не больше budget.
+	 * ~~~~ Примечания:
+	 * Если all == false, поиск завершается при извлечении первой метки вершины w и
+	 * возвращается ее индекс (оптимальный путь); иначе строится весь Парето-фронт
+	 * вершины w (bag[w]), возвращаемое значение - -1. Возвращает -1, если пути нет
+	 * или поиск прерван по control (nullptr - без ограничений).
+	*/
+	int solve(int v, int w, int budget, bool all, SearchControl *control);
+
+	/* Вспомогательная функция восстановления пути по цепочке меток от метки id. */
+	vector<int> trace(int id);
+public:
+	/*
+	 * Конструктор. Ресурс каждой дуги равен 1 (ограничение количества дуг пути).
+	*/
+	ConstrainedPathSearcher(const Graph &G);
+
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; resource(v, w, c) - функция, возвращающая неотрицательный ресурс
+	 * дуги (v, w) стоимостью c (вызывается один раз для каждой дуги при построении).
+	*/
+	ConstrainedPathSearcher(const Graph &G, const function<int(int, int, int)> &resource);
+
+	/*
+	 * Функция возвращает стоимость кратчайшего пути из вершины v в вершину w с
+	 * суммарным ресурсом не больше budget либо INF_COST, если такого пути нет.
+	 * control - управление поиском (nullptr - без ограничений).
+	*/
+	int distance(int v, int w, int budget, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает кратчайший путь из вершины v в вершину w с ресурсом не
+	 * больше budget (при равной стоимости - с наименьшим ресурсом) в виде вектора
+	 * номеров вершин (пустой вектор, если такого пути нет).
+	*/
+	vector<int> path(int v, int w, int budget, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает строку с путем (см. path()) в формате "v-k1-...-kn-w, P"
+	 * (см. ShortestPathSearcher); если пути нет - строку "v-w, inf".
+	*/
+	string get_path(int v, int w, int budget, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает Парето-фронт путей из вершины v в вершину w с ресурсом не
+	 * больше budget: для каждого пути фронта нет пути, не худшего по обоим критериям
+	 * и лучшего хотя бы по одному. Пути упорядочены по возрастанию стоимости
+	 * (и убыванию ресурса).
+	*/
+	vector<result> pareto(int v, int w, int budget = INF_COST, SearchControl *control = nullptr);
+
+	/* Функция возвращает количество меток, созданных последним поиском. */
+	inline int last_labels() const;
+
+	/* Функция возвращает статистику последнего запроса. */
+	inline const Stats &statistics() const;
+};
+
+#endif // _CONSTRAINED_PATH_SEARCHER_
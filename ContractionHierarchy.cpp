@@ -0,0 +1,362 @@
+#include "ContractionHierarchy.hpp"
+
+// Вспомогательная функция добавления ребра (u, w) стоимостью c в граф сжатия.
+// Если ребро уже существует и не дешевле c, граф не изменяется, иначе стоимость
+// и промежуточная вершина ребра обновляются в списках out[u] и in[w].
+template<typename Graph, typename Stats>
+void ContractionHierarchy<Graph, Stats>::add_arc(int u, int w, int c, int mid) {
+	for(auto &a : out[u])
+		if(a.to == w) {
+			if(a.c <= c)
+				return;
+			a.c = c, a.mid = mid;
+			for(auto &b : in[w])
+				if(b.to == u)
+					b.c = c, b.mid = mid;
+			return;
+		}
+	out[u].push_back({w, c, mid});
+	in[w].push_back({u, c, mid});
+}
+
+// Вспомогательная функция поиска свидетелей из вершины u. Вершина v и сжатые
+// вершины пропускаются; поиск прекращается, когда минимальная стоимость в куче
+// превышает limit или обработано max_settled вершин.
+template<typename Graph, typename Stats>
+void ContractionHierarchy<Graph, Stats>::witness_search(int u, int v, int limit, int max_settled) {
+	dist_f[u] = 0;
+	touched_f.push_back(u);
+	heap_f.push(u, 0);
+	for(int settled = 0; !heap_f.empty() && settled < max_settled; ++settled) {
+		if(heap_f.top_key() > limit)
+			break;
+		int x = heap_f.pop();
+		for(auto &a : out[x]) {
+			if(a.to == v || contracted[a.to])
+				continue;
+			int nd = dist_f[x] + a.c;
+			if(nd < dist_f[a.to]) {
+				if(dist_f[a.to] == INF_COST)
+					touched_f.push_back(a.to);
+				dist_f[a.to] = nd;
+				heap_f.push(a.to, nd);
+			}
+		}
+	}
+	heap_f.clear();
+}
+
+// Вспомогательная функция сжатия вершины v. Для каждой входящей дуги (u, v)
+// выполняется один поиск свидетелей, ограниченный стоимостью c(u, v) плюс
+// максимальная стоимость исходящей дуги v. Сокращение (u, w) требуется, если
+// найденное расстояние до w больше c(u, v) + c(v, w).
+// При simulate == true поиски свидетелей короче (SIMULATE_LIMIT): лишние
+// сокращения лишь завышают оценку приоритета, но не влияют на корректность.
+// При simulate == false вершина помечается сжатой, а ее дуги удаляются из
+// списков соседей, чтобы поиски свидетелей не просматривали сжатые вершины.
+template<typename Graph, typename Stats>
+int ContractionHierarchy<Graph, Stats>::contract(int v, bool simulate) {
+	int max_out = 0, cnt = 0;
+	for(auto &a : out[v])
+		if(!contracted[a.to] && a.to != v)
+			max_out = max(max_out, a.c);
+
+	for(size_t i = 0; i < in[v].size(); ++i) {
+		arc ua = in[v][i];
+		if(contracted[ua.to] || ua.to == v)
+			continue;
+
+		witness_search(ua.to, v, ua.c + max_out, simulate ? SIMULATE_LIMIT : WITNESS_LIMIT);
+		for(auto &vw : out[v]) {
+			if(contracted[vw.to] || vw.to == v || vw.to == ua.to)
+				continue;
+			if(dist_f[vw.to] <= ua.c + vw.c)
+				continue;
+			++cnt;
+			if(!simulate)
+				add_arc(ua.to, vw.to, ua.c + vw.c, v);
+		}
+
+		for(int x : touched_f)
+			dist_f[x] = INF_COST;
+		touched_f.clear();
+	}
+
+	if(!simulate) {
+		// Удаление дуг, ведущих в v и из v, из списков соседей:
+		auto to_v = [v](const arc &a) { return a.to == v; };
+		contracted[v] = 1;
+		for(auto &a : out[v]) {
+			++deleted_neighbors[a.to];
+			in[a.to].erase(remove_if(in[a.to].begin(), in[a.to].end(), to_v), in[a.to].end());
+		}
+		for(auto &a : in[v]) {
+			++deleted_neighbors[a.to];
+			out[a.to].erase(remove_if(out[a.to].begin(), out[a.to].end(), to_v), out[a.to].end());
+		}
+	}
+	return cnt;
+}
+
+// Вспомогательная функция вычисления приоритета вершины v: количество
+// необходимых сокращений минус количество удаляемых дуг плюс количество уже
+// сжатых соседей (равномерность сжатия по графу).
+template<typename Graph, typename Stats>
+int ContractionHierarchy<Graph, Stats>::priority(int v) {
+	int removed = 0;
+	for(auto &a : out[v])
+		removed += !contracted[a.to];
+	for(auto &a : in[v])
+		removed += !contracted[a.to];
+	return contract(v, true) - removed + deleted_neighbors[v];
+}
+
+// Вспомогательная функция построения графа поиска в формате CSR из списков дуг.
+template<typename Graph, typename Stats>
+void ContractionHierarchy<Graph, Stats>::build(search_graph &g, const vector<vector<arc>> &lists) {
+	g.offsets.assign(1, 0);
+	for(auto &list : lists) {
+		for(auto &a : list) {
+			g.targets.push_back(a.to);
+			g.costs.push_back(a.c);
+			g.mids.push_back(a.mid);
+		}
+		g.offsets.push_back(g.targets.size());
+	}
+}
+
+// Вспомогательная функция поиска ребра (from, to) в графе поиска.
+template<typename Graph, typename Stats>
+int ContractionHierarchy<Graph, Stats>::find_arc(const search_graph &g, int from, int to) {
+	for(int i = g.offsets[from]; i < g.offsets[from + 1]; ++i)
+		if(g.targets[i] == to)
+			return i;
+	return -1;
+}
+
+// Вспомогательная функция распаковки ребра (u, w) с промежуточной вершиной mid.
+// Вместо рекурсии используется явный стек. Ребро (a, m) сокращения (a, b) хранится
+// в down[m] (ранг a больше ранга m), ребро (m, b) - в up[m]. В path дописываются
+// вершины пути после u, включая w.
+template<typename Graph, typename Stats>
+void ContractionHierarchy<Graph, Stats>::unpack(int u, int w, int mid, vector<int> &path) const {
+	struct segment {
+		int a, b, mid;
+	};
+	vector<segment> stack = {{u, w, mid}};
+	while(!stack.empty()) {
+		segment e = stack.back();
+		stack.pop_back();
+		if(e.mid == -1) {
+			path.push_back(e.b);
+			continue;
+		}
+		int i = find_arc(up, e.mid, e.b), j = find_arc(down, e.mid, e.a);
+		stack.push_back({e.mid, e.b, up.mids[i]});
+		stack.push_back({e.a, e.mid, down.mids[j]});
+	}
+}
+
+// Основная функция запроса: двунаправленный поиск вверх по иерархии. На каждом
+// шаге обрабатывается направление с меньшей минимальной стоимостью в куче;
+// направление завершается, когда эта стоимость не меньше лучшего найденного
+// пути. Кандидаты в кратчайший путь проверяются в вершинах, обработанных в
+// обоих направлениях. Извлечение вершины из кучи засчитывается как шаг control.
+template<typename Graph, typename Stats>
+int ContractionHierarchy<Graph, Stats>::query(int s, int t, int &meet, SearchControl *control) {
+	stats.begin(QueryStats::SETUP);
+	for(int x : touched_f)
+		dist_f[x] = INF_COST, parent_f[x] = -1;
+	for(int x : touched_b)
+		dist_b[x] = INF_COST, parent_b[x] = -1;
+	touched_f.assign(1, s);
+	touched_b.assign(1, t);
+	heap_f.clear();
+	heap_b.clear();
+
+	dist_f[s] = 0, dist_b[t] = 0;
+	heap_f.push(s, 0);
+	heap_b.push(t, 0);
+	int best = INF_COST;
+	meet = -1;
+	stats.begin(QueryStats::SEARCH);
+	while(!heap_f.empty() || !heap_b.empty()) {
+		bool forward = !heap_f.empty() && (heap_b.empty() || heap_f.top_key() <= heap_b.top_key());
+		DaryHeap<4> &heap = (forward ? heap_f : heap_b);
+		vector<int> &dist = (forward ? dist_f : dist_b), &other = (forward ? dist_b : dist_f);
+		vector<int> &parent = (forward ? parent_f : parent_b);
+		vector<int> &touched = (forward ? touched_f : touched_b);
+		const search_graph &g = (forward ? up : down);
+
+		if(heap.top_key() >= best) {
+			heap.clear();
+			continue;
+		}
+		if(control && !control->step()) {
+			meet = -1;
+			return INF_COST;
+		}
+		int u = heap.pop();
+		stats.expand();
+		if(other[u] != INF_COST && dist[u] + other[u] < best)
+			best = dist[u] + other[u], meet = u;
+
+		stats.scan(g.offsets[u + 1] - g.offsets[u]);
+		for(int i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+			int x = g.targets[i], nd = dist[u] + g.costs[i];
+			if(nd < dist[x]) {
+				if(dist[x] == INF_COST)
+					touched.push_back(x);
+				dist[x] = nd;
+				parent[x] = u;
+				heap.push(x, nd);
+			}
+		}
+	}
+	return best;
+}
+
+// Конструктор. Строит граф сжатия из CSR-представления G (без петель), вычисляет
+// начальные приоритеты и сжимает вершины в порядке возрастания приоритета.
+// После сжатия вершины пересчитываются приоритеты ее соседей; кроме того,
+// приоритет извлеченной вершины пересчитывается (ленивое обновление), и если он
+// стал больше минимального в очереди, вершина возвращается в очередь.
+// Если обработка прервана по control, оставшиеся вершины получают старшие ранги
+// без сжатия, а все дуги между ними попадают в оба графа поиска (ядро): из вершины
+// ядра прямой поиск проходит по всем исходящим дугам, обратный - по всем входящим.
+template<typename Graph, typename Stats>
+ContractionHierarchy<Graph, Stats>::ContractionHierarchy(const Graph &G, SearchControl *control) :
+	v_cnt(G.V()), core(0), rank(G.V(), -1), out(G.V()), in(G.V()), contracted(G.V(), 0),
+	deleted_neighbors(G.V(), 0), dist_f(G.V(), INF_COST), dist_b(G.V(), INF_COST),
+	parent_f(G.V(), -1), parent_b(G.V(), -1), heap_f(G.V()), heap_b(G.V())
+{
+	CsrGraph csr(G);
+	for(int v = 0; v < v_cnt; ++v)
+		for(int i = csr.first(v); i < csr.last(v); ++i)
+			if(csr.target(i) != v)
+				add_arc(v, csr.target(i), csr.cost(i), -1);
+
+	DaryHeap<4> order(v_cnt);
+	for(int v = 0; v < v_cnt; ++v) {
+		if(control && !control->step())
+			break;
+		order.push(v, priority(v));
+	}
+
+	vector<vector<arc>> up_lists(v_cnt), down_lists(v_cnt);
+	int r = 0;
+	while(!order.empty()) {
+		if(control && !control->poll())
+			break;
+		int v = order.pop(), p = priority(v);
+		if(!order.empty() && p > order.top_key()) {
+			order.push(v, p);
+			continue;
+		}
+
+		for(auto &a : out[v])
+			if(!contracted[a.to])
+				up_lists[v].push_back(a);
+		for(auto &a : in[v])
+			if(!contracted[a.to])
+				down_lists[v].push_back(a);
+		contract(v, false);
+		rank[v] = r++;
+		vector<arc>().swap(out[v]);
+		vector<arc>().swap(in[v]);
+
+		// Обновление приоритетов соседей, изменившихся после сжатия v:
+		for(auto &a : up_lists[v])
+			order.update(a.to, priority(a.to));
+		for(auto &a : down_lists[v])
+			order.update(a.to, priority(a.to));
+	}
+
+	// Ядро: вершины, не сжатые до остановки обработки.
+	for(int v = 0; v < v_cnt; ++v) {
+		if(contracted[v])
+			continue;
+		++core;
+		rank[v] = r++;
+		for(auto &a : out[v])
+			if(!contracted[a.to])
+				up_lists[v].push_back(a);
+		for(auto &a : in[v])
+			if(!contracted[a.to])
+				down_lists[v].push_back(a);
+	}
+
+	build(up, up_lists);
+	build(down, down_lists);
+	vector<vector<arc>>().swap(out);
+	vector<vector<arc>>().swap(in);
+}
+
+// Функция возвращает количество добавленных ребер-сокращений.
+template<typename Graph, typename Stats>
+int ContractionHierarchy<Graph, Stats>::shortcuts() const {
+	int cnt = 0;
+	for(int m : up.mids)
+		cnt += (m != -1);
+	for(int m : down.mids)
+		cnt += (m != -1);
+	return cnt;
+}
+
+// Функция возвращает количество вершин ядра.
+template<typename Graph, typename Stats>
+int ContractionHierarchy<Graph, Stats>::core_size() const { return core; }
+
+// Функция возвращает стоимость кратчайшего пути из вершины v в вершину w.
+template<typename Graph, typename Stats>
+int ContractionHierarchy<Graph, Stats>::distance(int v, int w, SearchControl *control) {
+	stats.reset();
+	int meet, d = INF_COST;
+	if(v >= 0 && w >= 0 && v < v_cnt && w < v_cnt)
+		d = query(v, w, meet, control);
+	stats.end();
+	return d;
+}
+
+// Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+// w и его стоимостью в формате: "v-k1-k2-...-kn-w, P". Путь до вершины встречи
+// восстанавливается по предкам прямого поиска, путь от нее - по предкам
+// обратного поиска; каждое ребро иерархии распаковывается функцией unpack().
+template<typename Graph, typename Stats>
+string ContractionHierarchy<Graph, Stats>::get_path(int v, int w, SearchControl *control) {
+	stats.reset();
+	int meet = -1, d = INF_COST;
+	if(v >= 0 && w >= 0 && v < v_cnt && w < v_cnt)
+		d = query(v, w, meet, control);
+	if(d == INF_COST) {
+		stats.begin(QueryStats::FORMATTING);
+		string res = PathTracer::format(v, w);
+		stats.allocate(res.size());
+		stats.end();
+		return res;
+	}
+
+	stats.begin(QueryStats::RECONSTRUCTION);
+	vector<int> chain;
+	for(int x = meet; x != -1; x = parent_f[x])
+		chain.push_back(x);
+	reverse(chain.begin(), chain.end());
+
+	vector<int> path = {v};
+	for(size_t i = 0; i + 1 < chain.size(); ++i)
+		unpack(chain[i], chain[i + 1], up.mids[find_arc(up, chain[i], chain[i + 1])], path);
+	for(int x = meet; parent_b[x] != -1; x = parent_b[x])
+		unpack(x, parent_b[x], down.mids[find_arc(down, parent_b[x], x)], path);
+	stats.path();
+	stats.allocate(path.size() * sizeof(int));
+
+	stats.begin(QueryStats::FORMATTING);
+	string res = PathTracer::format(path, d);
+	stats.allocate(res.size());
+	stats.end();
+	return res;
+}
+
+// Функция возвращает статистику последнего запроса.
+template<typename Graph, typename Stats>
+const Stats &ContractionHierarchy<Graph, Stats>::statistics() const { return stats; }
\ No newline at end of file
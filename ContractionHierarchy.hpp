@@ -0,0 +1,151 @@
+#ifndef _CONTRACTION_HIERARCHY_
+#define _CONTRACTION_HIERARCHY_
+
+#include "main_header.hpp"
+#include "PathTracer.hpp"
+#include "CsrGraph.hpp"
+#include "DaryHeap.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс поиска кратчайших путей в графе Graph при помощи иерархии
+ * сжатий (Contraction Hierarchies).
+ * ~~~~ Примечания:
+ * При предварительной обработке вершины по очереди "сжимаются" (удаляются из
+ * графа) в порядке возрастания приоритета - разности числа добавляемых сокращений
+ * и числа удаляемых ребер (edge difference). При сжатии вершины v для каждой пары
+ * ребер (u, v), (v, w) добавляется ребро-сокращение (u, w), если поиск свидетеля
+ * не нашел пути из u в w в обход v не дороже c(u, v) + c(v, w).
+ * Результат - два графа в формате CSR: граф "вверх" (ребра к вершинам с большим
+ * рангом) и обратный граф "вниз". Запрос - двунаправленный поиск, в котором оба
+ * направления поднимаются только к вершинам большего ранга; найденный путь
+ * распаковывается через промежуточные вершины сокращений в путь исходного графа.
+ * Предварительную обработку можно прервать (см. SearchControl): условия остановки
+ * проверяются перед сжатием каждой вершины. Несжатые к моменту остановки вершины
+ * образуют ядро (core), в котором оба направления поиска просматривают все дуги
+ * без ограничения по рангу: запросы остаются точными, но просматривают больше
+ * вершин. В запросе шагом считается извлечение вершины из кучи; прерванный запрос
+ * возвращает отсутствие пути.
+ * Stats - политика статистики запросов (см. NoStats, CountingStats): каждый запрос
+ * сбрасывает статистику и учитывает извлеченные из куч вершины, просмотренные дуги
+ * иерархии, распакованный путь и время этапов (распаковка сокращений относится к
+ * этапу восстановления пути). Предварительная обработка не учитывается.
+ * Стоимости ребер графа должны быть неотрицательными. Запросы изменяют внутренние
+ * буферы, поэтому экземпляр не предназначен для одновременного использования
+ * из нескольких потоков.
+*/
+template<typename Graph, typename Stats = NoStats>
+class ContractionHierarchy {
+private:
+	/* Ребро графа при сжатии: конечная вершина, стоимость, промежуточная вершина (-1 для исходных). */
+	struct arc {
+		int to, c, mid;
+	};
+
+	/* Граф поиска в формате CSR с промежуточными вершинами сокращений. */
+	struct search_graph {
+		vector<int> offsets, targets, costs, mids;
+	};
+
+	/*
+	 * Ограничения количества обрабатываемых вершин при поиске свидетеля: при сжатии
+	 * и при оценке приоритета вершины.
+	*/
+	static const int WITNESS_LIMIT = 500, SIMULATE_LIMIT = 50;
+
+	int v_cnt, core;
+	/* rank[v] - номер вершины v в порядке сжатия (вершины ядра - после сжатых). */
+	vector<int> rank;
+	/* up: ребра (v, w), rank[w] > rank[v]; down: для ребра (u, v), rank[u] > rank[v], хранится (v -> u). */
+	search_graph up, down;
+
+	/* Буферы предварительной обработки. */
+	vector<vector<arc>> out, in;
+	vector<char> contracted;
+	vector<int> deleted_neighbors;
+
+	/* Буферы поиска (поиска свидетелей и запросов). */
+	vector<int> dist_f, dist_b, parent_f, parent_b, touched_f, touched_b;
+	DaryHeap<4> heap_f, heap_b;
+
+	/* Статистика последнего запроса. */
+	Stats stats;
+
+	/* Вспомогательная функция добавления или удешевления ребра (u, w) в графе сжатия. */
+	void add_arc(int u, int w, int c, int mid);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Вспомогательная функция сжатия вершины v.
+	 * ~~~~ Примечания:
+	 * Если simulate == true, граф не изменяется, а функция лишь подсчитывает
+	 * количество необходимых сокращений. Возвращает это количество.
+	*/
+	int contract(int v, bool simulate);
+
+	/*
+	 * Вспомогательная функция поиска свидетелей: поиск Дейкстры из u в графе без
+	 * сжатых вершин и без вершины v, ограниченный стоимостью limit и количеством
+	 * обработанных вершин max_settled. Результат - в dist_f (сбрасывается
+	 * вызывающим кодом).
+	*/
+	void witness_search(int u, int v, int limit, int max_settled);
+
+	/* Вспомогательная функция вычисления приоритета вершины v (edge difference). */
+	int priority(int v);
+
+	/* Вспомогательная функция построения графа поиска в формате CSR. */
+	static void build(search_graph &g, const vector<vector<arc>> &lists);
+
+	/* Вспомогательная функция поиска ребра (from, to) в графе поиска; возвращает индекс или -1. */
+	static int find_arc(const search_graph &g, int from, int to);
+
+	/*
+	 * Вспомогательная функция распаковки ребра (u, w) иерархии в последовательность
+	 * промежуточных вершин исходного графа (дописываются в path, без u и w).
+	*/
+	void unpack(int u, int w, int mid, vector<int> &path) const;
+
+	/*
+	 * Основная функция запроса: двунаправленный поиск вверх по иерархии.
+	 * Возвращает стоимость пути (INF_COST, если поиск прерван по control), в meet
+	 * записывает вершину встречи.
+	*/
+	int query(int s, int t, int &meet, SearchControl *control);
+public:
+	/*
+	 * Конструктор. Выполняет предварительную обработку графа G; control -
+	 * управление обработкой (nullptr - без ограничений).
+	*/
+	ContractionHierarchy(const Graph &G, SearchControl *control = nullptr);
+
+	/* Функция возвращает количество добавленных ребер-сокращений. */
+	inline int shortcuts() const;
+
+	/*
+	 * Функция возвращает количество вершин ядра - вершин, не сжатых из-за остановки
+	 * предварительной обработки (0, если обработка завершена).
+	*/
+	inline int core_size() const;
+
+	/*
+	 * Функция возвращает стоимость кратчайшего пути из вершины v в вершину w
+	 * либо INF_COST, если пути не существует или поиск прерван по control.
+	*/
+	int distance(int v, int w, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+	 * w и его стоимостью в формате: "v-k1-k2-...-kn-w, P" (см. ShortestPathSearcher).
+	 * Путь распакован: содержит только вершины и ребра исходного графа. Если пути
+	 * не существует (или поиск прерван по control), возвращается строка "v-w, inf".
+	*/
+	string get_path(int v, int w, SearchControl *control = nullptr);
+
+	/* Функция возвращает статистику последнего запроса. */
+	inline const Stats &statistics() const;
+};
+
+#endif // _CONTRACTION_HIERARCHY_
\ No newline at end of file
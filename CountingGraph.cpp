@@ -0,0 +1,73 @@
+#include "CountingGraph.hpp"
+
+// Конструктор.
+template<typename Graph, typename Stats>
+CountingGraph<Graph, Stats>::CountingGraph(const Graph &graph, Stats &stats) :
+	G(graph), stats(stats) { }
+
+// Функции, передающие вызов исходному графу.
+template<typename Graph, typename Stats>
+int CountingGraph<Graph, Stats>::V() const { return G.V(); }
+
+template<typename Graph, typename Stats>
+int CountingGraph<Graph, Stats>::E() const { return G.E(); }
+
+template<typename Graph, typename Stats>
+bool CountingGraph<Graph, Stats>::directed() const { return G.directed(); }
+
+template<typename Graph, typename Stats>
+unsigned long long CountingGraph<Graph, Stats>::version() const { return G.version(); }
+
+// Функции проверки существования ребра.
+template<typename Graph, typename Stats>
+int CountingGraph<Graph, Stats>::edge(Edge e) const { return edge(e.v, e.w); }
+
+template<typename Graph, typename Stats>
+int CountingGraph<Graph, Stats>::edge(int v, int w) const {
+	stats.lookup();
+	return G.edge(v, w);
+}
+
+// Функции подписки на изменения исходного графа.
+template<typename Graph, typename Stats>
+void CountingGraph<Graph, Stats>::subscribe(GraphObserver *o) const { G.subscribe(o); }
+
+template<typename Graph, typename Stats>
+void CountingGraph<Graph, Stats>::unsubscribe(GraphObserver *o) const { G.unsubscribe(o); }
+
+// Функция возвращает исходный граф.
+template<typename Graph, typename Stats>
+const Graph &CountingGraph<Graph, Stats>::base() const { return G; }
+
+/* Выражения (1), (2), (3), (4) и (5) ниже описывают класс итератора смежных вершин
+класса CountingGraph: */
+
+// Вспомогательная функция учета смежной вершины u. Значение, возвращаемое
+// исходным итератором после окончания перебора, не учитывается.
+template<typename Graph, typename Stats>
+int CountingGraph<Graph, Stats>::adjIterator::count(int u) {
+	if(!iter.end())
+		stats.scan();
+	return u;
+}
+
+// Конструктор. G - обертка графа, v - номер вершины.
+template<typename Graph, typename Stats>
+CountingGraph<Graph, Stats>::adjIterator::adjIterator(const CountingGraph &G, int v) :	// (1)
+	iter(G.G, v), stats(G.stats) { }													//
+
+// Методы begin() и next() передают вызов итератору исходного графа и учитывают
+// возвращенную вершину.
+template<typename Graph, typename Stats>
+int CountingGraph<Graph, Stats>::adjIterator::begin() { return count(iter.begin()); }	// (2)
+
+template<typename Graph, typename Stats>
+int CountingGraph<Graph, Stats>::adjIterator::next() { return count(iter.next()); }	// (3)
+
+// Метод проверки текущего состояния итератора.
+template<typename Graph, typename Stats>
+bool CountingGraph<Graph, Stats>::adjIterator::end() { return iter.end(); }	// (4)
+
+// Метод возвращает стоимость ребра в текущую смежную вершину.
+template<typename Graph, typename Stats>
+int CountingGraph<Graph, Stats>::adjIterator::cost() const { return iter.cost(); }	// (5)
@@ -0,0 +1,75 @@
+#ifndef _COUNTING_GRAPH_
+#define _COUNTING_GRAPH_
+
+#include "main_header.hpp"
+#include "GraphObserver.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Обертка графа Graph любого типа проекта (DenseGraph, SparseGraph, CsrGraph),
+ * учитывающая обращения к графу в статистике Stats (см. CountingStats): каждый
+ * вызов edge() - как lookup(), каждая смежная вершина, возвращенная итератором, -
+ * как scan().
+ * ~~~~ Примечания:
+ * Предоставляет интерфейс графа только для чтения (V(), E(), edge(), adjIterator и
+ * т.д.) и может передаваться вместо исходного графа классам, которые обращаются
+ * к графу через этот интерфейс (DeepSearcher, DijkstraSearcher). Классы,
+ * копирующие граф в CsrGraph или матрицы при построении (BucketSearcher,
+ * AltSearcher, ContractionHierarchy, BatchSearcher, ShortestPathSearcher и др.),
+ * после этого к исходному графу не обращаются, поэтому обертка их запросов не
+ * измеряет: такие классы параметризованы политикой статистики Stats и собирают ее
+ * сами (см. statistics()). Изменения графа выполняются через исходный граф;
+ * подписка на изменения (subscribe()) передается ему. Обертка хранит ссылки на
+ * граф и статистику, которые должны существовать, пока используется обертка.
+*/
+template<typename Graph, typename Stats = CountingStats>
+class CountingGraph {
+private:
+	const Graph &G;
+	Stats &stats;
+public:
+	/* Конструктор. Принимает граф G и статистику stats, в которой учитываются обращения. */
+	CountingGraph(const Graph &G, Stats &stats);
+
+	/* Функции, передающие вызов исходному графу. */
+	inline int V() const;
+	inline int E() const;
+	inline bool directed() const;
+	inline unsigned long long version() const;
+
+	/* Функции проверки существования ребра (учитываются как lookup()). */
+	inline int edge(Edge e) const;
+	inline int edge(int v, int w) const;
+
+	/* Функции подписки на изменения исходного графа (см. GraphObserver). */
+	inline void subscribe(GraphObserver *o) const;
+	inline void unsubscribe(GraphObserver *o) const;
+
+	/* Функция возвращает исходный граф. */
+	inline const Graph &base() const;
+
+	/*
+	 * Класс, представляющий итератор смежных вершин обертки: итератор исходного
+	 * графа, учитывающий каждую возвращенную смежную вершину как scan().
+	*/
+	class adjIterator {
+	private:
+		typename Graph::adjIterator iter;
+		Stats &stats;
+
+		/* Вспомогательная функция учета вершины u, возвращенной итератором. */
+		inline int count(int u);
+	public:
+		/* Конструктор. Принимает обертку G и номер вершины v. */
+		adjIterator(const CountingGraph &G, int v);
+
+		/* Методы begin(), next(), end() и cost() - см. Graph::adjIterator. */
+		int begin();
+		int next();
+		bool end();
+		int cost() const;
+	};
+};
+
+#endif // _COUNTING_GRAPH_
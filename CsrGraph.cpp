@@ -0,0 +1,156 @@
+#include "CsrGraph.hpp"
+
+// Вспомогательная функция построения графа из вектора дуг arcs. Дуги с
+// некорректными номерами вершин пропускаются. Сортировка подсчетом по начальной
+// вершине устойчива, поэтому после сортировки списков по конечной вершине
+// (также устойчивой) первой из повторяющихся дуг остается дуга, встретившаяся
+// в arcs раньше других.
+void CsrGraph::build(vector<Edge> arcs) {
+	offsets.assign(v_cnt + 1, 0);
+	for(auto &e : arcs)
+		if(e.v >= 0 && e.v < v_cnt && e.w >= 0 && e.w < v_cnt)
+			++offsets[e.v + 1];
+	for(int v = 0; v < v_cnt; ++v)
+		offsets[v + 1] += offsets[v];
+
+	vector<int> pos(offsets.begin(), offsets.end() - 1);
+	vector<Edge> sorted(offsets[v_cnt]);
+	for(auto &e : arcs)
+		if(e.v >= 0 && e.v < v_cnt && e.w >= 0 && e.w < v_cnt)
+			sorted[pos[e.v]++] = e;
+
+	targets.clear();
+	costs.clear();
+	targets.reserve(sorted.size());
+	costs.reserve(sorted.size());
+	int written = 0;
+	for(int v = 0; v < v_cnt; ++v) {
+		auto b = sorted.begin() + offsets[v], e = sorted.begin() + offsets[v + 1];
+		stable_sort(b, e, [](const Edge &x, const Edge &y) { return x.w < y.w; });
+		offsets[v] = written;
+		for(auto it = b; it != e; ++it)
+			if(it == b || it->w != (it - 1)->w) {
+				targets.push_back(it->w);
+				costs.push_back(it->c);
+				++written;
+			}
+	}
+	offsets[v_cnt] = written;
+}
+
+// Конструктор. Строит CSR-представление графа G любого типа проекта.
+template<typename Graph>
+CsrGraph::CsrGraph(const Graph &G) :
+	v_cnt(G.V()), _directed(G.directed()), _version(G.version())
+{
+	vector<Edge> arcs;
+	arcs.reserve(G.E());
+	for(int v = 0; v < v_cnt; ++v) {
+		typename Graph::adjIterator iter(G, v);
+		for(int w = iter.begin(); !iter.end(); w = iter.next())
+			arcs.push_back(Edge(v, w, iter.cost()));
+	}
+	build(move(arcs));
+}
+
+// Конструктор. Строит граф из вектора дуг arcs.
+CsrGraph::CsrGraph(int V, const vector<Edge> &arcs, bool _directed, unsigned long long _version) :
+	v_cnt(V), _directed(_directed), _version(_version) { build(arcs); }
+
+// Функция возвращает количество вершин в графе.
+int CsrGraph::V() const { return v_cnt; }
+
+// Функция возвращает количество ребер (дуг) в графе.
+int CsrGraph::E() const { return targets.size(); }
+
+// Функция проверки ориентированности графа.
+bool CsrGraph::directed() const { return _directed; }
+
+// Функция возвращает номер версии графа.
+unsigned long long CsrGraph::version() const { return _version; }
+
+// Функции подписки на изменения графа. Граф неизменяем, поэтому подписка не хранится.
+void CsrGraph::subscribe(GraphObserver *) const { }
+
+void CsrGraph::unsubscribe(GraphObserver *) const { }
+
+// Функция проверки существования в графе ребра e.
+int CsrGraph::edge(Edge e) const { return edge(e.v, e.w); }
+
+// Функция проверки существования в графе ребра из вершины v в вершину w.
+// Если ребро существует, функция возвращает его стоимость, иначе возвращает 0.
+int CsrGraph::edge(int v, int w) const {
+	if(v < 0 || v >= v_cnt)
+		return 0;
+	auto b = targets.begin() + offsets[v], e = targets.begin() + offsets[v + 1];
+	auto it = lower_bound(b, e, w);
+	if(it == e || *it != w)
+		return 0;
+	return costs[it - targets.begin()];
+}
+
+// Функции возвращают границы индексов ребер вершины v.
+int CsrGraph::first(int v) const { return offsets[v]; }
+int CsrGraph::last(int v) const { return offsets[v + 1]; }
+
+// Функции возвращают конечную вершину и стоимость ребра с индексом i.
+int CsrGraph::target(int i) const { return targets[i]; }
+int CsrGraph::cost(int i) const { return costs[i]; }
+
+// Функция возвращает граф с обращенными дугами.
+CsrGraph CsrGraph::reversed() const {
+	vector<Edge> arcs;
+	arcs.reserve(targets.size());
+	for(int v = 0; v < v_cnt; ++v)
+		for(int i = offsets[v]; i < offsets[v + 1]; ++i)
+			arcs.push_back(Edge(targets[i], v, costs[i]));
+	return CsrGraph(v_cnt, arcs, _directed, _version);
+}
+
+// Функция возвращает контрольную сумму графа. Каждое число добавляется в сумму
+// побайтно (FNV-1a, 64 бита).
+unsigned long long CsrGraph::checksum() const {
+	unsigned long long h = 14695981039346656037ULL;
+	auto add = [&](unsigned int x) {
+		for(int b = 0; b < 4; ++b, x >>= 8)
+			h = (h ^ (x & 0xff)) * 1099511628211ULL;
+	};
+	add(v_cnt);
+	for(int x : offsets)
+		add(x);
+	for(int x : targets)
+		add(x);
+	for(int x : costs)
+		add(x);
+	return h;
+}
+
+/* Выражения (1), (2), (3), (4) и (5) ниже описывают класс внутреннего итератора для
+класса CsrGraph: */
+
+// Конструктор. G - граф, к которому применяется итератор, v - номер вершины,
+// смежные с которой возвращаются методами begin(), next() и end().
+CsrGraph::adjIterator::adjIterator(const CsrGraph &G, int v) :	// (1)
+	curr(0), stop(0), G(G)										//
+{																//
+	if(v >= 0 && v < G.v_cnt)									//
+		curr = G.offsets[v], stop = G.offsets[v + 1];			//
+}																//
+
+// Метод возвращает индекс первой вершины, смежной с вершиной v.
+int CsrGraph::adjIterator::begin() {				// (2)
+	return curr < stop ? G.targets[curr] : -1;	//
+}												//
+
+// Метод возвращает индекс следующей смежной вершины и изменяет текущее
+// состояние итератора.
+int CsrGraph::adjIterator::next() {					// (3)
+	return ++curr < stop ? G.targets[curr] : -1;	//
+}													//
+
+// Метод проверки текущего состояния итератора. Если все смежные с v вершины
+// пройдены, будет возвращено true, иначе false.
+bool CsrGraph::adjIterator::end() { return curr >= stop; }	// (4)
+
+// Метод возвращает стоимость ребра из вершины v в текущую смежную вершину.
+int CsrGraph::adjIterator::cost() const { return G.costs[curr]; }	// (5)
\ No newline at end of file
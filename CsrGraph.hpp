@@ -0,0 +1,138 @@
+#ifndef _CSR_GRAPH_
+#define _CSR_GRAPH_
+
+#include "main_header.hpp"
+#include "GraphObserver.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Класс представляет неизменяемый граф в сжатом построчном формате (CSR): смежные
+ * вершины всех вершин хранятся подряд в одном векторе, границы списков задаются
+ * вектором смещений. Удобен для быстрых алгоритмов поиска, многократно
+ * обходящих все ребра графа.
+ * ~~~~ Примечания:
+ * Может быть построен из графа любого типа проекта (DenseGraph, SparseGraph),
+ * предоставляет тот же интерфейс (V(), E(), edge(), adjIterator), поэтому может
+ * использоваться вместо исходного графа в любом классе поиска. Смежные вершины
+ * каждой вершины упорядочены по возрастанию номера.
+*/
+class CsrGraph {
+private:
+	/* Построитель заполняет векторы графа напрямую (см. ConcurrentGraphBuilder::build()). */
+	friend class ConcurrentGraphBuilder;
+
+	int v_cnt;
+	bool _directed;
+	/* Ребра вершины v имеют индексы [offsets[v], offsets[v + 1]). */
+	vector<int> offsets, targets, costs;
+	/* Номер версии графа (см. version()). */
+	unsigned long long _version;
+
+	/*
+	 * Вспомогательная функция построения графа из вектора дуг arcs. Дуги
+	 * сортируются по начальной вершине (сортировкой подсчетом), затем каждый
+	 * список - по конечной; из повторяющихся дуг сохраняется первая.
+	*/
+	void build(vector<Edge> arcs);
+public:
+	/*
+	 * Конструктор. Строит CSR-представление графа G любого типа проекта,
+	 * обходя списки смежных вершин при помощи Graph::adjIterator.
+	*/
+	template<typename Graph>
+	explicit CsrGraph(const Graph &G);
+
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * V - количество вершин; arcs - дуги графа (для неориентированного графа
+	 * должны содержать оба направления каждого ребра); _directed - признак
+	 * ориентированности графа; _version - номер версии графа (см. version()).
+	*/
+	CsrGraph(int V, const vector<Edge> &arcs, bool _directed = true, unsigned long long _version = 0);
+
+	/* Функция возвращает количество вершин в графе. */
+	inline int V() const;
+
+	/* Функция возвращает количество ребер (дуг) в графе. */
+	inline int E() const;
+
+	/* Функция проверки графа на ориентированность. */
+	inline bool directed() const;
+
+	/*
+	 * Функция возвращает номер версии графа: для графа, построенного по графу G
+	 * другого типа, - значение G.version() на момент построения, иначе - номер,
+	 * переданный конструктору. Граф неизменяем, поэтому номер постоянен.
+	*/
+	inline unsigned long long version() const;
+
+	/*
+	 * Функции подписки и отписки наблюдателя o на изменения графа (см.
+	 * GraphObserver). Граф неизменяем, поэтому уведомлений не бывает и функции
+	 * ничего не делают; они позволяют использовать CsrGraph в классах поиска,
+	 * подписывающихся на изменения (ShortestPathSearcher, AllPairsSearcher).
+	*/
+	inline void subscribe(GraphObserver *o) const;
+	inline void unsubscribe(GraphObserver *o) const;
+
+	/*
+	 * Функция проверки существования ребра e. Если ребро существует, функция
+	 * возвращает его стоимость, иначе возвращает 0.
+	*/
+	inline int edge(Edge e) const;
+
+	/*
+	 * Функция проверки существования ребра, ведущего из вершины v в вершину w.
+	 * Если ребро существует, функция возвращает его стоимость, иначе возвращает 0.
+	 * Выполняется двоичным поиском за O(log deg(v)).
+	*/
+	int edge(int v, int w) const;
+
+	/* Функции возвращают границы [first(v), last(v)) индексов ребер вершины v. */
+	inline int first(int v) const;
+	inline int last(int v) const;
+
+	/* Функции возвращают конечную вершину и стоимость ребра с индексом i. */
+	inline int target(int i) const;
+	inline int cost(int i) const;
+
+	/* Функция возвращает граф с обращенными дугами (транспонированный граф). */
+	CsrGraph reversed() const;
+
+	/*
+	 * Функция возвращает контрольную сумму графа (FNV-1a по количеству вершин,
+	 * смещениям, конечным вершинам и стоимостям дуг). Используется для проверки
+	 * того, что сохраненные в файл результаты предварительной обработки построены
+	 * для того же графа: в отличие от version(), сумма не зависит от истории
+	 * изменений и совпадает для равных графов, построенных в разных запусках.
+	*/
+	unsigned long long checksum() const;
+
+	/*
+	 * Класс, представляющий итератор смежных вершин графа CsrGraph. Интерфейс
+	 * совпадает с итераторами DenseGraph и SparseGraph.
+	*/
+	class adjIterator {
+	private:
+		int curr, stop;
+		const CsrGraph &G;
+	public:
+		/* Конструктор. Принимает граф G и номер вершины v. */
+		adjIterator(const CsrGraph &G, int v);
+
+		/* Метод возвращает номер первой смежной вершины (-1, если их нет). */
+		int begin();
+
+		/* Метод возвращает номер следующей смежной вершины (-1, если ее нет). */
+		int next();
+
+		/* Метод проверки текущего состояния итератора (true, если вершины пройдены). */
+		bool end();
+
+		/* Метод возвращает стоимость ребра, ведущего в текущую смежную вершину. */
+		int cost() const;
+	};
+};
+
+#endif // _CSR_GRAPH_
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "DagSearcher.hpp"
+
+// Функция построения топологического порядка (алгоритм Кана): вершины без
+// входящих дуг помещаются в очередь; при извлечении вершины у ее преемников
+// уменьшается количество необработанных входящих дуг. Если в очередь попали не
+// все вершины, оставшиеся лежат на циклах или достижимы из них.
+template<typename Graph, typename Stats>
+bool DagSearcher<Graph, Stats>::topological_order(const Graph &G, vector<int> &order) {
+	int n = G.V();
+	vector<int> in(n, 0);
+	for(int v = 0; v < n; ++v) {
+		typename Graph::adjIterator iter(G, v);
+		for(int u = iter.begin(); !iter.end(); u = iter.next())
+			++in[u];
+	}
+
+	order.clear();
+	order.reserve(n);
+	for(int v = 0; v < n; ++v)
+		if(in[v] == 0)
+			order.push_back(v);
+	for(size_t h = 0; h < order.size(); ++h) {
+		typename Graph::adjIterator iter(G, order[h]);
+		for(int u = iter.begin(); !iter.end(); u = iter.next())
+			if(--in[u] == 0)
+				order.push_back(u);
+	}
+	return (int)order.size() == n;
+}
+
+// Конструктор.
+template<typename Graph, typename Stats>
+DagSearcher<Graph, Stats>::DagSearcher(const Graph &graph) :
+	G(graph), v_cnt(graph.V()), pos(graph.V(), -1), dist(graph.V(), INF_COST),
+	parent(graph.V(), -1), source(-1), last(SHORTEST)
+{
+	dag = DagSearcher<CsrGraph>::topological_order(G, topo);
+	if(!dag)
+		topo.clear();
+	for(int k = 0; k < (int)topo.size(); ++k)
+		pos[topo[k]] = k;
+}
+
+// Функция проверки графа на ацикличность.
+template<typename Graph, typename Stats>
+bool DagSearcher<Graph, Stats>::acyclic() const { return dag; }
+
+// Функция возвращает вершины графа в топологическом порядке.
+template<typename Graph, typename Stats>
+const vector<int> &DagSearcher<Graph, Stats>::order() const { return topo; }
+
+// Функция возвращает позицию вершины v в топологическом порядке.
+template<typename Graph, typename Stats>
+int DagSearcher<Graph, Stats>::position(int v) const { return pos[v]; }
+
+// Вспомогательная функция прохода из вершины s. Вершины, предшествующие s в
+// топологическом порядке, из s недостижимы, поэтому проход начинается с позиции s.
+// Шагом control считается обработка достижимой вершины.
+template<typename Graph, typename Stats>
+template<typename Counter>
+bool DagSearcher<Graph, Stats>::pass(int s, objective o, int *d, int *p, SearchControl *control,
+		Counter &counter) const
+{
+	fill(d, d + v_cnt, INF_COST);
+	fill(p, p + v_cnt, -1);
+	d[s] = 0;
+	for(int k = pos[s]; k < v_cnt; ++k) {
+		int u = topo[k];
+		if(d[u] == INF_COST)
+			continue;
+		if(control && !control->step())
+			return false;
+		counter.expand();
+		counter.scan(G.last(u) - G.first(u));
+		for(int i = G.first(u); i < G.last(u); ++i) {
+			int x = G.target(i), c = d[u] + G.cost(i);
+			if(d[x] == INF_COST || (o == SHORTEST ? c < d[x] : c > d[x])) {
+				d[x] = c;
+				p[x] = u;
+			}
+		}
+	}
+	return true;
+}
+
+// Функция прохода из вершины s (без статистики).
+template<typename Graph, typename Stats>
+bool DagSearcher<Graph, Stats>::sweep(int s, objective o, int *d, int *p, SearchControl *control) const {
+	NoStats none;
+	return pass(s, o, d, p, control, none);
+}
+
+// Вспомогательная функция поиска из вершины s. Прерванный проход не запоминается
+// как последний.
+template<typename Graph, typename Stats>
+bool DagSearcher<Graph, Stats>::search(int s, objective o, SearchControl *control) {
+	stats.begin(QueryStats::SEARCH);
+	if(!dag || s < 0 || s >= v_cnt)
+		return false;
+	if(source != s || last != o) {
+		source = -1;
+		if(!pass(s, o, dist.data(), parent.data(), control, stats))
+			return false;
+		source = s, last = o;
+	}
+	return true;
+}
+
+// Основная функция: поиск оптимальных путей из вершины s во все вершины.
+template<typename Graph, typename Stats>
+bool DagSearcher<Graph, Stats>::run(int s, objective o, SearchControl *control) {
+	stats.reset();
+	bool res = search(s, o, control);
+	stats.end();
+	return res;
+}
+
+// Вспомогательная функция, возвращающая стоимость оптимального пути из v в w.
+template<typename Graph, typename Stats>
+int DagSearcher<Graph, Stats>::query(int v, int w, objective o, SearchControl *control) {
+	stats.begin(QueryStats::SETUP);
+	if(w < 0 || w >= v_cnt || !search(v, o, control))
+		return INF_COST;
+	return dist[w];
+}
+
+// Функция возвращает стоимость оптимального пути из вершины v в вершину w.
+template<typename Graph, typename Stats>
+int DagSearcher<Graph, Stats>::distance(int v, int w, objective o, SearchControl *control) {
+	stats.reset();
+	int d = query(v, w, o, control);
+	stats.end();
+	return d;
+}
+
+// Функция возвращает оптимальный путь из вершины v в вершину w. Путь
+// восстанавливается по предшественникам от w к v (см. PathTracer).
+template<typename Graph, typename Stats>
+vector<int> DagSearcher<Graph, Stats>::path(int v, int w, objective o, SearchControl *control) {
+	stats.reset();
+	vector<int> res;
+	if(query(v, w, o, control) != INF_COST) {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		PathTracer::from_predecessors([&](int u) { return parent[u]; }, v, w, res);
+		stats.path();
+		stats.allocate(res.size() * sizeof(int));
+	}
+	stats.end();
+	return res;
+}
+
+// Функция возвращает строку с оптимальным путем из вершины v в вершину w.
+template<typename Graph, typename Stats>
+string DagSearcher<Graph, Stats>::get_path(int v, int w, objective o, SearchControl *control) {
+	stats.reset();
+	int d = query(v, w, o, control);
+	string res;
+	if(d == INF_COST) {
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(v, w);
+	}
+	else {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		vector<int> path;
+		PathTracer::from_predecessors([&](int u) { return parent[u]; }, v, w, path);
+		stats.path();
+		stats.allocate(path.size() * sizeof(int));
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(path, d);
+	}
+	stats.allocate(res.size());
+	stats.end();
+	return res;
+}
+
+// Функция возвращает статистику последнего запроса.
+template<typename Graph, typename Stats>
+const Stats &DagSearcher<Graph, Stats>::statistics() const { return stats; }
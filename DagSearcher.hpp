@@ -0,0 +1,128 @@
+#ifndef _DAG_SEARCHER_
+#define _DAG_SEARCHER_
+
+#include "main_header.hpp"
+#include "CsrGraph.hpp"
+#include "PathTracer.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс поиска кратчайших и длиннейших путей в ациклическом
+ * ориентированном графе (DAG) Graph за O(V + E).
+ * ~~~~ Примечания:
+ * Конструктор проверяет граф на ацикличность и один раз строит топологический
+ * порядок (алгоритм Кана). Пути из вершины s вычисляются одним проходом по
+ * вершинам в топологическом порядке, начиная с s: к моменту обработки вершины все
+ * входящие в нее дуги уже релаксированы, поэтому очередь с приоритетами не нужна,
+ * а стоимости ребер могут быть отрицательными. Длиннейший путь вычисляется тем же
+ * проходом с заменой минимума на максимум.
+ * Неориентированный граф с хотя бы одним ребром ацикличным не считается (каждое
+ * ребро образует цикл из двух дуг). Если граф содержит цикл, поиск не выполняется.
+ * Проход можно прервать (см. SearchControl): обработка вершины засчитывается как
+ * шаг; прерванный проход не сохраняется, а запрос возвращает отсутствие пути.
+ * Stats - политика статистики запросов (см. NoStats, CountingStats): каждый вызов
+ * run(), distance(), path() и get_path() сбрасывает статистику и учитывает
+ * обработанные достижимые вершины, просмотренные дуги, найденный путь и время
+ * этапов. Функция sweep() статистику не собирает.
+ * Экземпляр описывает граф на момент построения.
+*/
+template<typename Graph, typename Stats = NoStats>
+class DagSearcher {
+public:
+	/* Критерий оптимальности пути. */
+	enum objective { SHORTEST, LONGEST };
+private:
+	CsrGraph G;
+	int v_cnt;
+	bool dag;
+	/* topo - вершины в топологическом порядке; pos[v] - позиция вершины v в topo. */
+	vector<int> topo, pos;
+
+	/* Результат последнего поиска (см. run()). */
+	vector<int> dist, parent;
+	int source;
+	objective last;
+
+	/* Статистика последнего запроса. */
+	Stats stats;
+
+	/* Вспомогательная функция прохода (см. sweep()), учитывающая события в counter. */
+	template<typename Counter>
+	bool pass(int s, objective o, int *dist, int *parent, SearchControl *control,
+		Counter &counter) const;
+
+	/* Вспомогательная функция поиска из вершины s (см. run()) без сброса статистики. */
+	bool search(int s, objective o, SearchControl *control);
+
+	/* Вспомогательная функция ответа на запрос (v, w) (см. distance()) без сброса статистики. */
+	int query(int v, int w, objective o, SearchControl *control);
+public:
+	/* Конструктор. Строит CSR-представление графа G и топологический порядок. */
+	DagSearcher(const Graph &G);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция построения топологического порядка order вершин графа G любого типа
+	 * проекта (алгоритм Кана).
+	 * ~~~~ Примечания:
+	 * Возвращает false, если граф содержит цикл (order в этом случае содержит
+	 * только часть вершин). Не требует построения экземпляра класса.
+	*/
+	static bool topological_order(const Graph &G, vector<int> &order);
+
+	/* Функция проверки графа на ацикличность. */
+	inline bool acyclic() const;
+
+	/* Функция возвращает вершины графа в топологическом порядке (пустой вектор для графа с циклом). */
+	inline const vector<int> &order() const;
+
+	/* Функция возвращает позицию вершины v в топологическом порядке. */
+	inline int position(int v) const;
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция прохода из вершины s: записывает в dist стоимости оптимальных
+	 * (по критерию o) путей из s во все вершины (INF_COST - вершина недостижима),
+	 * в parent - предшественников вершин на этих путях (-1 для s и недостижимых).
+	 * ~~~~ Примечания:
+	 * Буферы dist и parent должны вмещать V() значений. Не изменяет экземпляр,
+	 * поэтому может вызываться одновременно из нескольких потоков (с разными
+	 * control либо без них). Возвращает false, если проход прерван по control
+	 * (nullptr - без ограничений); буферы тогда содержат неокончательные значения.
+	*/
+	bool sweep(int s, objective o, int *dist, int *parent, SearchControl *control = nullptr) const;
+
+	/*
+	 * Основная функция: поиск оптимальных путей из вершины s во все вершины.
+	 * Возвращает false, если граф содержит цикл, s - недопустимая вершина или
+	 * поиск прерван по control (nullptr - без ограничений).
+	*/
+	bool run(int s, objective o = SHORTEST, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает стоимость оптимального пути из вершины v в вершину w по
+	 * критерию o либо INF_COST, если пути не существует (граф содержит цикл или
+	 * поиск прерван по control).
+	*/
+	int distance(int v, int w, objective o = SHORTEST, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает оптимальный путь из вершины v в вершину w по критерию o в
+	 * виде вектора номеров вершин (пустой вектор, если пути не существует).
+	*/
+	vector<int> path(int v, int w, objective o = SHORTEST, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает строку с оптимальным путем из вершины v в вершину w в
+	 * формате "v-k1-k2-...-kn-w, P" (см. ShortestPathSearcher); если пути не
+	 * существует - строку "v-w, inf".
+	*/
+	string get_path(int v, int w, objective o = SHORTEST, SearchControl *control = nullptr);
+
+	/* Функция возвращает статистику последнего запроса. */
+	inline const Stats &statistics() const;
+};
+
+#endif // _DAG_SEARCHER_
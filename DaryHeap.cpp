@@ -0,0 +1,122 @@
+#include "DaryHeap.hpp"
+
+// Вспомогательная функция "всплытия" элемента с индексом i к корню кучи.
+template<int D>
+void DaryHeap<D>::sift_up(int i) {
+	item x = heap[i];
+	while(i > 0) {
+		int parent = (i - 1) / D;
+		if(heap[parent].key <= x.key)
+			break;
+		heap[i] = heap[parent];
+		pos[heap[i].v] = i;
+		i = parent;
+	}
+	heap[i] = x;
+	pos[x.v] = i;
+}
+
+// Вспомогательная функция "погружения" элемента с индексом i к листьям кучи.
+// Среди D потомков выбирается потомок с минимальным приоритетом.
+template<int D>
+void DaryHeap<D>::sift_down(int i) {
+	item x = heap[i];
+	int n = heap.size();
+	while(true) {
+		int first = i * D + 1;
+		if(first >= n)
+			break;
+		int last = min(first + D, n), best = first;
+		for(int c = first + 1; c < last; ++c)
+			if(heap[c].key < heap[best].key)
+				best = c;
+		if(heap[best].key >= x.key)
+			break;
+		heap[i] = heap[best];
+		pos[heap[i].v] = i;
+		i = best;
+	}
+	heap[i] = x;
+	pos[x.v] = i;
+}
+
+// Конструктор. n - количество вершин.
+template<int D>
+DaryHeap<D>::DaryHeap(int n) : pos(n, -1) { heap.reserve(n); }
+
+// Функция изменения количества допустимых элементов. Очищает кучу.
+template<int D>
+void DaryHeap<D>::resize(int n) {
+	heap.clear();
+	heap.reserve(n);
+	pos.assign(n, -1);
+}
+
+// Функция проверки кучи на пустоту.
+template<int D>
+bool DaryHeap<D>::empty() const { return heap.empty(); }
+
+// Функция проверки наличия вершины v в куче.
+template<int D>
+bool DaryHeap<D>::contains(int v) const { return pos[v] != -1; }
+
+// Функция добавления вершины v с приоритетом key либо уменьшения ее приоритета.
+template<int D>
+void DaryHeap<D>::push(int v, int key) {
+	if(pos[v] == -1) {
+		heap.push_back({key, v});
+		sift_up(heap.size() - 1);
+	}
+	else if(key < heap[pos[v]].key) {
+		heap[pos[v]].key = key;
+		sift_up(pos[v]);
+	}
+}
+
+// Функция установки приоритета key вершины v. В зависимости от знака изменения
+// вершина "всплывает" или "погружается".
+template<int D>
+void DaryHeap<D>::update(int v, int key) {
+	if(pos[v] == -1) {
+		push(v, key);
+		return;
+	}
+	int old = heap[pos[v]].key;
+	heap[pos[v]].key = key;
+	if(key < old)
+		sift_up(pos[v]);
+	else
+		sift_down(pos[v]);
+}
+
+// Функция возвращает вершину с минимальным приоритетом.
+template<int D>
+int DaryHeap<D>::top() const { return heap[0].v; }
+
+// Функция возвращает минимальный приоритет.
+template<int D>
+int DaryHeap<D>::top_key() const { return heap[0].key; }
+
+// Функция извлечения вершины с минимальным приоритетом.
+template<int D>
+int DaryHeap<D>::pop() {
+	int v = heap[0].v;
+	pos[v] = -1;
+	if(heap.size() > 1) {
+		heap[0] = heap.back();
+		heap.pop_back();
+		sift_down(0);
+	}
+	else
+		heap.pop_back();
+	return v;
+}
+
+// Функция очистки кучи. Сбрасываются позиции только тех вершин, которые
+// находятся в куче, поэтому время работы не зависит от общего числа вершин.
+template<int D>
+void DaryHeap<D>::clear() {
+	for(auto &x : heap)
+		pos[x.v] = -1;
+	heap.clear();
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef _DARY_HEAP_
+#define _DARY_HEAP_
+
+#include "main_header.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Индексированная D-арная куча (очередь с приоритетами) для поиска кратчайших путей.
+ * Элементами кучи являются номера вершин [0, n), приоритетами - стоимости путей.
+ * ~~~~ Примечания:
+ * Поддерживает операцию уменьшения приоритета (decrease) за O(log_D n). Память под
+ * кучу выделяется один раз (см. конструктор и метод resize()), метод clear()
+ * очищает кучу за время, пропорциональное количеству находящихся в ней элементов,
+ * поэтому один экземпляр можно переиспользовать между запросами без перевыделения.
+*/
+template<int D = 4>
+class DaryHeap {
+private:
+	/* Элемент кучи: приоритет key вершины v. */
+	struct item {
+		int key, v;
+	};
+
+	vector<item> heap;
+	/* pos[v] - индекс вершины v в векторе heap, либо -1, если вершины в куче нет. */
+	vector<int> pos;
+
+	/* Вспомогательные функции восстановления свойства кучи для элемента с индексом i. */
+	inline void sift_up(int i);
+	inline void sift_down(int i);
+public:
+	/* Конструктор. n - количество вершин (допустимые элементы кучи: 0, ..., n - 1). */
+	DaryHeap(int n = 0);
+
+	/* Функция изменения количества допустимых элементов. Очищает кучу. */
+	void resize(int n);
+
+	/* Функция проверки кучи на пустоту. */
+	inline bool empty() const;
+
+	/* Функция проверки наличия вершины v в куче. */
+	inline bool contains(int v) const;
+
+	/*
+	 * Функция добавления вершины v с приоритетом key. Если вершина уже находится в
+	 * куче и ее приоритет больше key, приоритет уменьшается до key.
+	 */
+	inline void push(int v, int key);
+
+	/*
+	 * Функция установки приоритета key вершины v (как уменьшения, так и увеличения).
+	 * Если вершины нет в куче, она добавляется.
+	 */
+	inline void update(int v, int key);
+
+	/* Функция возвращает вершину с минимальным приоритетом, не извлекая ее. */
+	inline int top() const;
+
+	/* Функция возвращает минимальный приоритет среди вершин в куче. */
+	inline int top_key() const;
+
+	/* Функция извлечения вершины с минимальным приоритетом. Возвращает номер вершины. */
+	inline int pop();
+
+	/* Функция очистки кучи. Выполняется за время, пропорциональное размеру кучи. */
+	void clear();
+};
+
+#endif // _DARY_HEAP_
\ No newline at end of file
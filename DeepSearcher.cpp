@@ -12,16 +12,28 @@
 // #4 marked - вектор пройденных на предыдущих шагах вершин (при первом вызове пуст,
 // см. реализацию метода get_paths());
 // #5 curr_costs - числовое значение, представляющее стоимость пути prior_path (при первом
-// вызове равен 0).
-template<typename Graph>
-vector<string> DeepSearcher<Graph>::_get_paths(int v, int w,
-		string prior_path, vector<int> marked, int curr_costs) const
+// вызове равен 0);
+// #6 control - управление поиском: каждый вызов засчитывается как шаг, каждый
+// найденный путь - как результат; после остановки вызовы возвращают пустой вектор.
+template<typename Graph, typename Stats>
+vector<string> DeepSearcher<Graph, Stats>::_get_paths(int v, int w,
+		string prior_path, vector<int> marked, int curr_costs, SearchControl *control) const
 {
+	if(control && !control->step())
+		return {};
+
 	// Если искомая вершина w достигнута:
-	if(v == w)
-		return {prior_path + "-" + to_string(v) + ", " + to_string(curr_costs)};
+	if(v == w) {
+		if(control)
+			control->found();
+		string path = prior_path + "-" + to_string(v) + ", " + to_string(curr_costs);
+		stats.path();
+		stats.allocate(path.size());
+		return {path};
+	}
 
 	vector<string> res, temp;
+	stats.expand();
 
 	// Корректировка параметров для последующих вызовов:
 	marked.push_back(v);
@@ -30,8 +42,12 @@ vector<string> DeepSearcher<Graph>::_get_paths(int v, int w,
 	// Цикл, рекурсивно вызывающий метод для каждой вершины, смежной с v:
 	typename Graph::adjIterator iter(G, v);
 	for(auto i = iter.begin(); !iter.end(); i = iter.next()) {
+		stats.scan();
+		if(pruned(i, w))
+			continue;
 		if(find(marked.begin(), marked.end(), i) == marked.end()) {
-			temp = _get_paths(i, w, prior_path, marked, curr_costs + G.edge(v, i));
+			stats.lookup();
+			temp = _get_paths(i, w, prior_path, marked, curr_costs + G.edge(v, i), control);
 			res.insert(res.end(), temp.begin(), temp.end());
 		}
 	}
@@ -39,12 +55,102 @@ vector<string> DeepSearcher<Graph>::_get_paths(int v, int w,
 	return res;
 }
 
+// Вариант метода _get_paths() для ациклического графа: без вектора пройденных вершин
+// и с отсечением вершин, стоящих в топологическом порядке после w.
+template<typename Graph, typename Stats>
+vector<string> DeepSearcher<Graph, Stats>::_get_dag_paths(int v, int w, const string &prior_path,
+		int curr_costs, const vector<int> &pos, SearchControl *control) const
+{
+	if(control && !control->step())
+		return {};
+
+	if(v == w) {
+		if(control)
+			control->found();
+		string path = prior_path + "-" + to_string(v) + ", " + to_string(curr_costs);
+		stats.path();
+		stats.allocate(path.size());
+		return {path};
+	}
+
+	vector<string> res, temp;
+	string path = prior_path + "-" + to_string(v);
+	stats.expand();
+
+	typename Graph::adjIterator iter(G, v);
+	for(auto i = iter.begin(); !iter.end(); i = iter.next()) {
+		stats.scan();
+		if(pos[i] > pos[w] || pruned(i, w))
+			continue;
+		temp = _get_dag_paths(i, w, path, curr_costs + iter.cost(), pos, control);
+		res.insert(res.end(), temp.begin(), temp.end());
+	}
+
+	return res;
+}
+
 // Конструктор.
-template<typename Graph>
-DeepSearcher<Graph>::DeepSearcher(const Graph &graph) : G(graph) {}
+template<typename Graph, typename Stats>
+DeepSearcher<Graph, Stats>::DeepSearcher(const Graph &graph, const ReachabilityIndex<Graph> *index) :
+	G(graph), index(index) {}
+
+// Вспомогательная функция, возвращающая топологический порядок текущей версии
+// графа. Порядок неизменяем после построения, поэтому вызывающий код читает его без
+// блокировки; при изменении графа строится и публикуется новый порядок.
+template<typename Graph, typename Stats>
+shared_ptr<const typename DeepSearcher<Graph, Stats>::dag_order>
+DeepSearcher<Graph, Stats>::topological() const {
+	lock_guard<mutex> guard(order_lock);
+	if(order && order->version == G.version())
+		return order;
+
+	shared_ptr<dag_order> o(new dag_order());
+	o->version = G.version();
+	vector<int> sorted;
+	o->dag = G.directed() && DagSearcher<Graph>::topological_order(G, sorted);
+	if(o->dag) {
+		o->pos.resize(G.V());
+		for(int k = 0; k < (int)sorted.size(); ++k)
+			o->pos[sorted[k]] = k;
+	}
+	order = o;
+	return order;
+}
+
+// Вспомогательная функция отсечения. Номер версии графа сравнивается при каждой
+// проверке: граф может измениться между запросами экземпляра.
+template<typename Graph, typename Stats>
+bool DeepSearcher<Graph, Stats>::pruned(int u, int w) const {
+	return index && index->version() == G.version() && !index->reachable(u, w);
+}
 
 // Метод для пользовательского использования. Делегирует задачу поиска методу _get_paths().
-template<typename Graph>
-vector<string> DeepSearcher<Graph>::get_paths(int v, int w) const {
-	return _get_paths(v, w, "", {}, 0);
-}
\ No newline at end of file
+template<typename Graph, typename Stats>
+vector<string> DeepSearcher<Graph, Stats>::get_paths(int v, int w, SearchControl *control) const {
+	stats.reset();
+	stats.begin(QueryStats::SETUP);
+	if(pruned(v, w)) {
+		stats.end();
+		return {};
+	}
+
+	shared_ptr<const dag_order> o = topological();
+
+	stats.begin(QueryStats::SEARCH);
+	vector<string> res = (o->dag ? _get_dag_paths(v, w, "", 0, o->pos, control) :
+		_get_paths(v, w, "", {}, 0, control));
+	stats.end();
+	return res;
+}
+
+// Функция возвращает генератор путей из v в w.
+template<typename Graph, typename Stats>
+PathGenerator<Graph, Stats> DeepSearcher<Graph, Stats>::lazy_paths(int v, int w,
+		SearchControl *control) const
+{
+	return PathGenerator<Graph, Stats>(G, v, w, index, control);
+}
+
+// Функция возвращает статистику последнего вызова get_paths().
+template<typename Graph, typename Stats>
+const Stats &DeepSearcher<Graph, Stats>::statistics() const { return stats; }
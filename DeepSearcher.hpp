@@ -2,15 +2,58 @@
 #define _DEEP_SEARCHER_
 
 #include "main_header.hpp"
+#include "ReachabilityIndex.hpp"
+#include "DagSearcher.hpp"
+#include "PathGenerator.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
 
 /*
  * ~~~~ Краткое описание класса:
  * Модульный класс поиска путей в графе Graph.
+ * ~~~~ Примечания:
+ * Топологический порядок (признак ацикличности) графа вычисляется при первом
+ * запросе и сохраняется вместе с номером версии графа (см. DenseGraph::version());
+ * повторно он вычисляется только после изменения графа.
+ * Stats - политика статистики запросов (см. NoStats, CountingStats). Каждый
+ * вызов get_paths() сбрасывает статистику и учитывает раскрытые вершины,
+ * просмотренные дуги, вызовы edge(), найденные пути и объем строк путей; этапы -
+ * подготовка (проверка ацикличности) и поиск (строки путей формируются во время
+ * поиска, поэтому отдельного этапа форматирования нет).
 */
-template<typename Graph>
+template<typename Graph, typename Stats = NoStats>
 class DeepSearcher {
 private:
 	const Graph &G;
+	/* Индекс достижимости для отсечения вершин, из которых конечная вершина недостижима. */
+	const ReachabilityIndex<Graph> *index;
+	/* Статистика последнего запроса get_paths(). */
+	mutable Stats stats;
+
+	/*
+	 * Топологический порядок графа версии version: dag - признак ацикличности
+	 * ориентированного графа, pos[v] - позиция вершины v в порядке (если dag).
+	*/
+	struct dag_order {
+		unsigned long long version;
+		bool dag;
+		vector<int> pos;
+	};
+	/* Порядок для последней версии графа; заменяется целиком под блокировкой order_lock. */
+	mutable shared_ptr<const dag_order> order;
+	mutable mutex order_lock;
+
+	/*
+	 * Вспомогательная функция, возвращающая топологический порядок текущей версии
+	 * графа (вычисляет его, если граф изменился). Потокобезопасна.
+	*/
+	shared_ptr<const dag_order> topological() const;
+
+	/*
+	 * Вспомогательная функция отсечения: true, если по индексу w недостижима из u.
+	 * Индекс, построенный для другой версии графа, не используется.
+	*/
+	inline bool pruned(int u, int w) const;
 
 	/*
 	 * ~~~~ Красткое описание метода:
@@ -25,13 +68,35 @@ private:
 	 * #4 marked - вектор пройденных на предыдущих шагах вершин (при первом вызове пуст,
 	 * см. реализацию метода get_paths());
 	 * #5 curr_costs - числовое значение, представляющее стоимость пути prior_path (при первом
-	 * вызове равен 0).
+	 * вызове равен 0);
+	 * #6 control - управление поиском (nullptr - без ограничений, см. SearchControl).
 	*/
 	vector<string> _get_paths(int v, int w, string prior_path,
-		vector<int> marked, int curr_costs) const;
+		vector<int> marked, int curr_costs, SearchControl *control) const;
+
+	/*
+	 * ~~~~ Красткое описание метода:
+	 * Вариант метода _get_paths() для ациклического графа.
+	 * ~~~~ Примечания:
+	 * Вектор пройденных вершин не ведется: в ациклическом графе путь не может
+	 * вернуться в пройденную вершину. Вершины, стоящие в топологическом порядке
+	 * после w, не просматриваются (w из них недостижима).
+	 * ~~~~ Описание параметров:
+	 * #1 v, #2 w, #3 prior_path, #4 curr_costs - см. _get_paths();
+	 * #5 pos - позиции вершин в топологическом порядке;
+	 * #6 control - см. _get_paths().
+	*/
+	vector<string> _get_dag_paths(int v, int w, const string &prior_path, int curr_costs,
+		const vector<int> &pos, SearchControl *control) const;
 public:
-	/* Конструктор. */
-	DeepSearcher(const Graph &G);
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; index - индекс достижимости графа G (nullptr - без отсечения). С индексом
+	 * поиск не переходит в вершины, из которых конечная вершина недостижима; после
+	 * изменения графа индекс не используется, пока он не построен заново.
+	*/
+	DeepSearcher(const Graph &G, const ReachabilityIndex<Graph> *index = nullptr);
 
 	/*
 	 * ~~~~ Краткое описание функции:
@@ -40,9 +105,32 @@ public:
 	 * Каждый элемент возвращаемого вектора содержит уникальный путь, записанный в строку
 	 * вида "-v-k1-k2-...-kn-w, costs", где k1, ..., kn - номера промежуточных вершин
 	 * на пути, а costs - числовое значение, равное стоимости соответствующего пути.
-	 * Использует внутренний метод _get_paths().
+	 * Использует внутренний метод _get_paths(); если ориентированный граф ацикличен
+	 * (проверяется за O(V + E) при первом вызове после изменения графа) - метод
+	 * _get_dag_paths().
+	 * Если задан control, поиск проверяет его на каждом шаге и при остановке
+	 * (отмена, крайний срок, ограничение количества путей) возвращает пути,
+	 * найденные до остановки; причина - control->result().
+	*/
+	vector<string> get_paths(int v, int w, SearchControl *control = nullptr) const;
+
+	/*
+	 * ~~~~ Краткое описание функции:
+	 * Функция возвращает генератор путей из вершины v в вершину w: пути того же
+	 * формата и в том же порядке, что и у get_paths(), но по одному по запросу
+	 * (см. PathGenerator).
+	 * ~~~~ Примечания:
+	 * Удобна для постраничного вывода и для графов, где полный перебор путей
+	 * занимает слишком много времени. Генератор ссылается на граф G, индекс и
+	 * control (см. PathGenerator).
+	*/
+	PathGenerator<Graph, Stats> lazy_paths(int v, int w, SearchControl *control = nullptr) const;
+
+	/*
+	 * Функция возвращает статистику последнего вызова get_paths() (статистику
+	 * генератора lazy_paths() возвращает PathGenerator::statistics()).
 	*/
-	vector<string> get_paths(int v, int w) const;
+	inline const Stats &statistics() const;
 };
 
 #endif // _DEEP_SEARCHER_
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "DeltaSteppingSearcher.hpp"
+
+// Вспомогательная функция упаковки пары (d, p). Сравнение упакованных значений
+// как беззнаковых чисел упорядочивает пары сначала по расстоянию, затем по предку.
+template<typename Graph, typename Stats>
+unsigned long long DeltaSteppingSearcher<Graph, Stats>::pack(int d, int p) {
+	return ((unsigned long long)(unsigned)d << 32) | (unsigned)(p + 1);
+}
+
+// Вспомогательная функция релаксации ребер вершин frontier со стоимостью в
+// диапазоне (lo, hi]. Поток t обрабатывает вершины с номерами t, t + T, ...;
+// новое значение записывается операцией compare-and-swap, если оно меньше
+// текущего, и тогда вершина добавляется в буфер improved[t]. Просмотренные дуги
+// поток считает в локальной переменной и записывает в scanned[t] один раз.
+template<typename Graph, typename Stats>
+void DeltaSteppingSearcher<Graph, Stats>::relax(const vector<int> &frontier, int lo, int hi,
+		vector<vector<int>> &improved)
+{
+	if(frontier.empty())
+		return;
+	int T = pool.size();
+	pool.run([&](int t) {
+		long long cnt = 0;
+		for(size_t k = t; k < frontier.size(); k += T) {
+			int u = frontier[k];
+			int du = (int)(state[u].load(memory_order_relaxed) >> 32);
+			cnt += G.last(u) - G.first(u);
+			for(int i = G.first(u); i < G.last(u); ++i) {
+				int c = G.cost(i);
+				if(c <= lo || c > hi)
+					continue;
+				int x = G.target(i);
+				unsigned long long nv = pack(du + c, u), cur = state[x].load(memory_order_relaxed);
+				while(nv < cur)
+					if(state[x].compare_exchange_weak(cur, nv, memory_order_relaxed)) {
+						improved[t].push_back(x);
+						break;
+					}
+			}
+		}
+		scanned[t] = cnt;
+	});
+	for(long long cnt : scanned)
+		stats.scan(cnt);
+}
+
+// Конструктор. Строит CSR-представление графа и выбирает ширину корзины.
+template<typename Graph, typename Stats>
+DeltaSteppingSearcher<Graph, Stats>::DeltaSteppingSearcher(const Graph &graph, int delta, int threads) :
+	G(graph), v_cnt(graph.V()), delta(delta), max_cost(1), pool(threads),
+	state(new atomic<unsigned long long>[graph.V()]), source(-1), scanned(pool.size(), 0)
+{
+	for(int i = 0; i < G.E(); ++i)
+		max_cost = max(max_cost, G.cost(i));
+	if(this->delta <= 0) {
+		int avg_deg = max(1, G.E() / max(1, v_cnt));
+		this->delta = max(1, max_cost / avg_deg);
+	}
+}
+
+// Функция поиска кратчайших путей из вершины s. Корзины хранятся циклически:
+// все оценки расстояний в любой момент лежат в пределах max_cost от начала текущей
+// корзины, поэтому достаточно max_cost / delta + 2 корзин. Устаревшие записи
+// (вершина, расстояние которой уменьшилось и которая перешла в другую корзину)
+// пропускаются при извлечении корзины. Корзина - крупный шаг (фаза пула потоков),
+// поэтому перед каждой непустой корзиной условия остановки проверяются сразу (poll()).
+template<typename Graph, typename Stats>
+bool DeltaSteppingSearcher<Graph, Stats>::search(int s, SearchControl *control) {
+	stats.begin(QueryStats::SEARCH);
+	const unsigned long long none = pack(INF_COST, -1);
+	for(int v = 0; v < v_cnt; ++v)
+		state[v].store(none, memory_order_relaxed);
+	source = s;
+	if(s < 0 || s >= v_cnt) {
+		dist.assign(v_cnt, INF_COST);
+		parent.assign(v_cnt, -1);
+		return true;
+	}
+
+	int nb = max_cost / delta + 2, pending = 1;
+	vector<vector<int>> buckets(nb), improved(pool.size());
+	vector<char> in_frontier(v_cnt, 0);
+	vector<int> frontier, settled;
+	auto bucket_of = [&](int v) { return (int)(state[v].load(memory_order_relaxed) >> 32) / delta; };
+	// Объединение буферов потоков в корзины:
+	auto merge = [&]() {
+		for(auto &buf : improved) {
+			for(int x : buf) {
+				buckets[bucket_of(x) % nb].push_back(x);
+				++pending;
+			}
+			buf.clear();
+		}
+	};
+
+	state[s].store(pack(0, -1));
+	buckets[0].push_back(s);
+	bool complete = true;
+	for(int i = 0; pending > 0; ++i) {
+		auto &bucket = buckets[i % nb];
+		if(control && !bucket.empty() && !control->poll()) {
+			complete = false;
+			source = -1;
+			break;
+		}
+		settled.clear();
+		while(!bucket.empty()) {
+			// Извлечение актуальных вершин корзины i без повторов:
+			frontier.clear();
+			pending -= bucket.size();
+			for(int v : bucket)
+				if(!in_frontier[v] && bucket_of(v) == i) {
+					in_frontier[v] = 1;
+					frontier.push_back(v);
+				}
+			bucket.clear();
+			for(int v : frontier) {
+				in_frontier[v] = 0;
+				settled.push_back(v);
+			}
+			stats.expand(frontier.size());
+
+			// Легкие ребра: могут вернуть вершины в текущую корзину.
+			relax(frontier, -INF_COST, delta, improved);
+			merge();
+		}
+
+		// Тяжелые ребра всех вершин, покинувших корзину i.
+		sort(settled.begin(), settled.end());
+		settled.erase(unique(settled.begin(), settled.end()), settled.end());
+		relax(settled, delta, INF_COST, improved);
+		merge();
+	}
+
+	dist.resize(v_cnt);
+	parent.resize(v_cnt);
+	for(int v = 0; v < v_cnt; ++v) {
+		unsigned long long x = state[v].load(memory_order_relaxed);
+		dist[v] = (int)(x >> 32);
+		parent[v] = (int)(x & 0xffffffffULL) - 1;
+	}
+	return complete;
+}
+
+// Функция поиска кратчайших путей из вершины s.
+template<typename Graph, typename Stats>
+bool DeltaSteppingSearcher<Graph, Stats>::run(int s, SearchControl *control) {
+	stats.reset();
+	bool complete = search(s, control);
+	stats.end();
+	return complete;
+}
+
+// Функции возвращают расстояния и предков, вычисленные последним вызовом run().
+template<typename Graph, typename Stats>
+const vector<int> &DeltaSteppingSearcher<Graph, Stats>::distances() const { return dist; }
+
+template<typename Graph, typename Stats>
+const vector<int> &DeltaSteppingSearcher<Graph, Stats>::parents() const { return parent; }
+
+// Вспомогательная функция, возвращающая стоимость кратчайшего пути из вершины v
+// в вершину w (поиск выполняется, если последний поиск был из другой вершины).
+template<typename Graph, typename Stats>
+int DeltaSteppingSearcher<Graph, Stats>::query(int v, int w, SearchControl *control) {
+	stats.begin(QueryStats::SETUP);
+	if(v < 0 || w < 0 || v >= v_cnt || w >= v_cnt)
+		return INF_COST;
+	if(source != v && !search(v, control))
+		return INF_COST;
+	return dist[w];
+}
+
+// Функция возвращает стоимость кратчайшего пути из вершины v в вершину w.
+template<typename Graph, typename Stats>
+int DeltaSteppingSearcher<Graph, Stats>::distance(int v, int w, SearchControl *control) {
+	stats.reset();
+	int d = query(v, w, control);
+	stats.end();
+	return d;
+}
+
+// Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+// w и его стоимостью в формате: "v-k1-k2-...-kn-w, P".
+template<typename Graph, typename Stats>
+string DeltaSteppingSearcher<Graph, Stats>::get_path(int v, int w, SearchControl *control) {
+	stats.reset();
+	int d = query(v, w, control);
+	string res;
+	if(d == INF_COST) {
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(v, w);
+	}
+	else {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		vector<int> path;
+		PathTracer::from_predecessors([&](int u) { return parent[u]; }, v, w, path);
+		stats.path();
+		stats.allocate(path.size() * sizeof(int));
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(path, d);
+	}
+	stats.allocate(res.size());
+	stats.end();
+	return res;
+}
+
+// Функция возвращает статистику последнего запроса.
+template<typename Graph, typename Stats>
+const Stats &DeltaSteppingSearcher<Graph, Stats>::statistics() const { return stats; }
\ No newline at end of file
@@ -0,0 +1,108 @@
+#ifndef _DELTA_STEPPING_SEARCHER_
+#define _DELTA_STEPPING_SEARCHER_
+
+#include "main_header.hpp"
+#include "PathTracer.hpp"
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс параллельного поиска кратчайших путей из одной вершины в графе
+ * Graph алгоритмом delta-stepping (Meyer, Sanders).
+ * ~~~~ Примечания:
+ * Вершины распределяются по "корзинам" ширины delta по текущей оценке расстояния.
+ * Корзины обрабатываются по возрастанию номера: легкие ребра (стоимостью не
+ * больше delta) релаксируются многократно, пока корзина не опустеет, тяжелые -
+ * один раз для всех вершин, покинувших корзину. Вершины корзины обрабатываются
+ * параллельно потоками пула; каждый поток накапливает улучшенные вершины в своем
+ * буфере, буферы объединяются после каждой фазы.
+ * Оценка расстояния и предок вершины хранятся в одном 64-битном атомарном слове и
+ * обновляются операцией compare-and-swap, поэтому в результате предком каждой
+ * вершины является вершина с минимальным номером среди тех, через которые
+ * проходит кратчайший путь; при единственности кратчайших путей дерево совпадает
+ * с деревом алгоритма Дейкстры. Стоимости ребер графа должны быть положительными.
+ * Поиск можно прервать (см. SearchControl): условия остановки проверяются перед
+ * обработкой каждой корзины. Прерванный поиск не запоминается (следующий запрос
+ * выполняет поиск заново), а запрос возвращает отсутствие пути.
+ * Stats - политика статистики запросов (см. NoStats, CountingStats): каждый вызов
+ * run(), distance() и get_path() сбрасывает статистику и учитывает вершины фронтов
+ * (раскрытия), просмотренные дуги, найденный путь и время этапов. Потоки считают
+ * дуги в собственных счетчиках, которые суммируются после каждой фазы.
+*/
+template<typename Graph, typename Stats = NoStats>
+class DeltaSteppingSearcher {
+private:
+	CsrGraph G;
+	int v_cnt, delta, max_cost;
+	ThreadPool pool;
+
+	/* Упакованные пары (расстояние, предок + 1) - см. pack(). */
+	unique_ptr<atomic<unsigned long long>[]> state;
+	/* Результаты последнего поиска. */
+	int source;
+	vector<int> dist, parent;
+
+	/* Статистика последнего запроса и счетчики просмотренных дуг потоков. */
+	Stats stats;
+	vector<long long> scanned;
+
+	/* Вспомогательная функция упаковки пары (d, p): старшие 32 бита - d, младшие - p + 1. */
+	static inline unsigned long long pack(int d, int p);
+
+	/*
+	 * Вспомогательная функция релаксации ребер вершин frontier со стоимостью
+	 * в диапазоне (lo, hi]. Улучшенные вершины записываются в буферы потоков.
+	*/
+	void relax(const vector<int> &frontier, int lo, int hi, vector<vector<int>> &improved);
+
+	/* Вспомогательная функция поиска из вершины s (см. run()) без сброса статистики. */
+	bool search(int s, SearchControl *control);
+
+	/* Вспомогательная функция ответа на запрос (v, w) (см. distance()) без сброса статистики. */
+	int query(int v, int w, SearchControl *control);
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; delta - ширина корзины (0 - выбирается по графу как отношение
+	 * максимальной стоимости ребра к средней степени вершины); threads -
+	 * количество потоков (0 - по количеству аппаратных потоков).
+	*/
+	DeltaSteppingSearcher(const Graph &G, int delta = 0, int threads = 0);
+
+	/*
+	 * Функция поиска кратчайших путей из вершины s во все вершины графа. Возвращает
+	 * false, если поиск прерван по control (nullptr - без ограничений).
+	*/
+	bool run(int s, SearchControl *control = nullptr);
+
+	/*
+	 * Функции возвращают расстояния и предков, вычисленные последним вызовом run()
+	 * (после прерванного поиска - оценки на момент остановки).
+	*/
+	inline const vector<int> &distances() const;
+	inline const vector<int> &parents() const;
+
+	/*
+	 * Функция возвращает стоимость кратчайшего пути из вершины v в вершину w
+	 * либо INF_COST, если пути не существует или поиск прерван по control.
+	 * Выполняет run(v), если последний поиск выполнялся из другой вершины.
+	*/
+	int distance(int v, int w, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+	 * w и его стоимостью в формате: "v-k1-k2-...-kn-w, P" (см. ShortestPathSearcher).
+	 * Если пути не существует (или поиск прерван по control), возвращается строка
+	 * "v-w, inf".
+	*/
+	string get_path(int v, int w, SearchControl *control = nullptr);
+
+	/* Функция возвращает статистику последнего вызова run(), distance() или get_path(). */
+	inline const Stats &statistics() const;
+};
+
+#endif // _DELTA_STEPPING_SEARCHER_
\ No newline at end of file
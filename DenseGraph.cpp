@@ -7,7 +7,7 @@
 // ~~~~ Примечания:
 // Параметр _directed имеет значение по умолчанию, равное true.
 DenseGraph::DenseGraph(int V, bool _directed) :
-	adjMatrix(V), v_cnt(V), e_cnt(0), _directed(_directed)
+	adjMatrix(V), v_cnt(V), e_cnt(0), _directed(_directed), _version(0)
 {
 	for(int v = 0; v < V; ++v)
 		adjMatrix[v].assign(V, 0);
@@ -48,6 +48,8 @@ void DenseGraph::insert(int v, int w, int c) {
 	if(!adjMatrix[v][w]) {
 		adjMatrix[v][w] = c;
 		++e_cnt;
+		++_version;
+		observers.notify(v, w, 0, c);
 
 		if(!_directed)
 			insert(w, v, c);
@@ -65,14 +67,25 @@ void DenseGraph::remove(int v, int w) {
 	if(v >= v_cnt || w >= v_cnt)
 		return;
 	if(adjMatrix[v][w]) {
+		int c = adjMatrix[v][w];
 		adjMatrix[v][w] = 0;
 		--e_cnt;
+		++_version;
+		observers.notify(v, w, c, 0);
 
 		if(!_directed)
 			remove(w, v);
 	}
 }
 
+// Функции подписки и отписки наблюдателя o на изменения графа.
+void DenseGraph::subscribe(GraphObserver *o) const { observers.subscribe(o); }
+
+void DenseGraph::unsubscribe(GraphObserver *o) const { observers.unsubscribe(o); }
+
+// Функция возвращает номер версии графа.
+unsigned long long DenseGraph::version() const { return _version; }
+
 
 // ~~~~ Описание метода:
 // Статический метод, идентифицирующий ребра, представленные в строке data,
@@ -101,8 +114,8 @@ void DenseGraph::scan_edges(vector<Edge> &edges, string data) {
 	}
 }
 
-/* Выражения (1), (2), (3) и (4) ниже описывают класс внутреннего итератора для
-класса SparseGraph: */
+/* Выражения (1), (2), (3), (4) и (5) ниже описывают класс внутреннего итератора для
+класса DenseGraph: */
 
 // Конструктор. G - граф, к которому применяется итератор, v - номер вершины,
 // смежные с которой возвращаются методами begin(), next() и end().
@@ -120,7 +133,7 @@ DenseGraph::adjIterator::adjIterator(const DenseGraph &G, int v) :	// (1)
 			break;													//
 		}															//
 	/* Определение текущего состояния итератора. */					//
-	curr = (first == -1 ? G.v_cnt : first + 1);						//
+	curr = (first == -1 ? G.v_cnt + 1 : first + 1);					//
 }																	//
 
 // Метод возвращает индекс первой вершины, смежной с вершиной v.
@@ -132,9 +145,17 @@ int DenseGraph::adjIterator::next() {				// (3)
 	for(; curr < G.v_cnt; ++curr)					//
 		if((V < G.v_cnt) && G.adjMatrix[V][curr])	//
 			return curr++;							//
+	curr = G.v_cnt + 1;								//
 	return -1;										//
 }													//
 
 // Метод проверки текущего состояния итератора. Если все смежные с v вершины
 // пройдены, будет возвращено true, иначе false.
-bool DenseGraph::adjIterator::end() { return curr >= G.v_cnt; }	// (4)
\ No newline at end of file
+// ~~~~ Примечания:
+// Значение curr, равное G.v_cnt, допустимо: оно означает, что текущей является
+// последняя вершина графа. Признаком конца служит значение G.v_cnt + 1,
+// устанавливаемое методом next().
+bool DenseGraph::adjIterator::end() { return curr > G.v_cnt; }	// (4)
+
+// Метод возвращает стоимость ребра из вершины v в текущую смежную вершину.
+int DenseGraph::adjIterator::cost() const { return G.adjMatrix[V][curr - 1]; }	// (5)
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "DijkstraSearcher.hpp"
+
+// Вспомогательная функция сброса буферов поиска. Сбрасываются только значения
+// вершин, затронутых последним поиском, поэтому время работы не зависит от V.
+template<typename Graph, typename Stats>
+void DijkstraSearcher<Graph, Stats>::reset() {
+	for(int u : touched) {
+		dist[u] = INF_COST;
+		parent[u] = -1;
+	}
+	touched.clear();
+	heap.clear();
+	last_source = last_target = -1;
+	settled = 0;
+}
+
+// Основная функция класса, выполняющая поиск из вершины s. Если t != -1, поиск
+// останавливается после извлечения вершины t из кучи (ее расстояние окончательно),
+// иначе строится полное дерево кратчайших путей. Прерванный поиск сбрасывает
+// стартовую вершину, чтобы следующий запрос не использовал неполные буферы.
+template<typename Graph, typename Stats>
+bool DijkstraSearcher<Graph, Stats>::run(int s, int t, SearchControl *control) {
+	stats.begin(QueryStats::SEARCH);
+	reset();
+	last_source = s, last_target = t;
+	last_version = G.version();
+
+	dist[s] = 0;
+	touched.push_back(s);
+	heap.push(s, 0);
+	while(!heap.empty()) {
+		if(control && !control->step()) {
+			last_source = last_target = -1;
+			return false;
+		}
+		int u = heap.pop();
+		++settled;
+		stats.expand();
+		if(u == t)
+			return true;
+
+		// Релаксация всех ребер, исходящих из вершины u:
+		typename Graph::adjIterator iter(G, u);
+		for(int i = iter.begin(); !iter.end(); i = iter.next()) {
+			stats.scan();
+			int d = dist[u] + iter.cost();
+			if(d < dist[i]) {
+				if(dist[i] == INF_COST)
+					touched.push_back(i);
+				dist[i] = d;
+				parent[i] = u;
+				heap.push(i, d);
+			}
+		}
+	}
+	return true;
+}
+
+// Вспомогательная функция, возвращающая кэшированное дерево кратчайших путей из
+// вершины v. Если дерева в кэше нет, но к вершине обращались не менее hot_threshold
+// раз, дерево строится, сохраняется в кэше (с вытеснением наиболее давно
+// использованного) и возвращается. В остальных случаях, а также если построение
+// дерева прервано, возвращает nullptr. Дерево, построенное для другой версии
+// графа, удаляется из кэша и строится заново.
+template<typename Graph, typename Stats>
+const typename DijkstraSearcher<Graph, Stats>::tree *DijkstraSearcher<Graph, Stats>::cached_tree(int v,
+		SearchControl *control)
+{
+	if(cache_capacity == 0)
+		return nullptr;
+
+	auto it = cache.find(v);
+	if(it != cache.end()) {
+		if(it->second.first.version == G.version()) {
+			lru.splice(lru.begin(), lru, it->second.second);
+			return &it->second.first;
+		}
+		lru.erase(it->second.second);
+		cache.erase(it);
+	}
+
+	if(++query_cnt[v] < hot_threshold)
+		return nullptr;
+
+	if(!run(v, -1, control))
+		return nullptr;
+	if((int)cache.size() >= cache_capacity) {
+		cache.erase(lru.back());
+		lru.pop_back();
+	}
+
+	lru.push_front(v);
+	auto &entry = cache[v];
+	entry.first.dist = dist;
+	entry.first.parent = parent;
+	entry.first.version = last_version;
+	entry.second = lru.begin();
+	stats.allocate(2LL * v_cnt * sizeof(int));
+	return &entry.first;
+}
+
+// Конструктор. Выделяет буферы поиска; предварительных вычислений не выполняет.
+template<typename Graph, typename Stats>
+DijkstraSearcher<Graph, Stats>::DijkstraSearcher(const Graph &graph, int cache_capacity,
+		int hot_threshold) :
+	G(graph), v_cnt(graph.V()), dist(graph.V(), INF_COST), parent(graph.V(), -1),
+	heap(graph.V()), last_source(-1), last_target(-1), last_version(0), settled(0),
+	cache_capacity(cache_capacity), hot_threshold(hot_threshold),
+	query_cnt(cache_capacity ? graph.V() : 0, 0) { }
+
+// Вспомогательная функция, подготавливающая ответ на запрос (v, w): берет дерево
+// из кэша либо выполняет поиск (если буферы не содержат результат для этого
+// запроса или построены для другой версии графа). Возвращает стоимость пути, в p записывается указатель на массив предков.
+template<typename Graph, typename Stats>
+int DijkstraSearcher<Graph, Stats>::search(int v, int w, const vector<int> *&p, SearchControl *control) {
+	if(const tree *T = cached_tree(v, control)) {
+		p = &T->parent;
+		return T->dist[w];
+	}
+	p = &parent;
+	if(control && control->stopped())
+		return INF_COST;
+	if((last_source != v || (last_target != -1 && last_target != w) || last_version != G.version()) &&
+			!run(v, w, control))
+		return INF_COST;
+	return dist[w];
+}
+
+// Функция возвращает стоимость кратчайшего пути из вершины v в вершину w
+// либо INF_COST, если пути не существует или поиск прерван.
+template<typename Graph, typename Stats>
+int DijkstraSearcher<Graph, Stats>::distance(int v, int w, SearchControl *control) {
+	stats.reset();
+	stats.begin(QueryStats::SETUP);
+	int d = INF_COST;
+	const vector<int> *p;
+	if(v >= 0 && w >= 0 && v < v_cnt && w < v_cnt)
+		d = search(v, w, p, control);
+	stats.end();
+	return d;
+}
+
+// Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+// w и его стоимостью в формате: "v-k1-k2-...-kn-w, P". Путь восстанавливается
+// по массиву предков от вершины w к вершине v.
+template<typename Graph, typename Stats>
+string DijkstraSearcher<Graph, Stats>::get_path(int v, int w, SearchControl *control) {
+	stats.reset();
+	stats.begin(QueryStats::SETUP);
+	const vector<int> *p = nullptr;
+	int d = INF_COST;
+	if(v >= 0 && w >= 0 && v < v_cnt && w < v_cnt)
+		d = search(v, w, p, control);
+
+	string res;
+	if(d == INF_COST) {
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(v, w);
+	}
+	else {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		vector<int> path;
+		PathTracer::from_predecessors([&](int u) { return (*p)[u]; }, v, w, path);
+		stats.path();
+		stats.allocate(path.size() * sizeof(int));
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(path, d);
+	}
+	stats.allocate(res.size());
+	stats.end();
+	return res;
+}
+
+// Функция возвращает количество вершин, окончательно обработанных последним поиском.
+template<typename Graph, typename Stats>
+int DijkstraSearcher<Graph, Stats>::last_settled() const { return settled; }
+
+// Функция очистки кэша деревьев кратчайших путей.
+template<typename Graph, typename Stats>
+void DijkstraSearcher<Graph, Stats>::clear_cache() {
+	cache.clear();
+	lru.clear();
+	query_cnt.assign(query_cnt.size(), 0);
+}
+
+// Функция возвращает статистику последнего запроса.
+template<typename Graph, typename Stats>
+const Stats &DijkstraSearcher<Graph, Stats>::statistics() const { return stats; }
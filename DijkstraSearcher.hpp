@@ -0,0 +1,132 @@
+#ifndef _DIJKSTRA_SEARCHER_
+#define _DIJKSTRA_SEARCHER_
+
+#include "main_header.hpp"
+#include "PathTracer.hpp"
+#include "DaryHeap.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс поиска кратчайших путей в графе Graph по запросу (алгоритм Дейкстры).
+ * ~~~~ Примечания:
+ * В отличие от ShortestPathSearcher, конструктор не выполняет предварительных
+ * вычислений: каждый запрос get_path(v, w) решается отдельным поиском из вершины v,
+ * который останавливается сразу после достижения вершины w. Буферы расстояний,
+ * предков и 4-арная куча выделяются один раз и переиспользуются между запросами.
+ * Для "горячих" стартовых вершин (к которым обращались не менее hot_threshold раз)
+ * может сохраняться полное дерево кратчайших путей (кэш на cache_capacity деревьев,
+ * вытеснение по давности использования).
+ * Поиск можно прервать (см. SearchControl): извлечение вершины из кучи
+ * засчитывается как шаг; прерванный поиск не сохраняется ни в буферах, ни в
+ * кэше, а запрос возвращает отсутствие пути.
+ * Буферы и деревья кэша помечаются версией графа (Graph::version()), при которой
+ * они построены: после изменения графа они не используются, поэтому запросы
+ * всегда отвечают по текущему состоянию графа.
+ * Стоимости ребер графа должны быть неотрицательными.
+ * Stats - политика статистики запросов (см. NoStats, CountingStats): каждый вызов
+ * distance() и get_path() сбрасывает статистику и учитывает извлеченные из кучи
+ * вершины, просмотренные дуги, найденный путь, объем деревьев кэша и результата,
+ * а также время этапов (подготовка, поиск, восстановление пути, форматирование).
+ * Экземпляр класса не предназначен для одновременного использования из нескольких
+ * потоков, так как запросы изменяют внутренние буферы.
+*/
+template<typename Graph, typename Stats = NoStats>
+class DijkstraSearcher {
+private:
+	/* Полное дерево кратчайших путей из некоторой вершины и версия графа, для которой оно построено. */
+	struct tree {
+		vector<int> dist, parent;
+		unsigned long long version;
+	};
+
+	const Graph &G;
+	int v_cnt;
+
+	/* Переиспользуемые буферы поиска. */
+	vector<int> dist, parent;
+	/* Вершины, значения dist и parent которых изменены последним поиском. */
+	vector<int> touched;
+	DaryHeap<4> heap;
+	/* Стартовая вершина и цель последнего поиска (-1, если поиск не выполнялся). */
+	int last_source, last_target;
+	/* Версия графа, для которой выполнен последний поиск. */
+	unsigned long long last_version;
+	/* Количество вершин, извлеченных из кучи (окончательно обработанных) последним поиском. */
+	int settled;
+
+	/* Кэш деревьев кратчайших путей для "горячих" стартовых вершин. */
+	int cache_capacity, hot_threshold;
+	vector<int> query_cnt;
+	list<int> lru;
+	unordered_map<int, pair<tree, list<int>::iterator>> cache;
+
+	/* Статистика последнего запроса. */
+	Stats stats;
+
+	/* Вспомогательная функция сброса буферов поиска. Выполняется за O(|touched|). */
+	void reset();
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Основная функция класса, выполняющая поиск из вершины s.
+	 * ~~~~ Примечания:
+	 * Если t != -1, поиск останавливается после извлечения вершины t из кучи,
+	 * иначе строится полное дерево кратчайших путей из s. Возвращает false, если
+	 * поиск прерван по control (nullptr - без ограничений).
+	*/
+	bool run(int s, int t, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция, возвращающая дерево кратчайших путей из вершины v,
+	 * если оно есть в кэше или вершина стала "горячей" (тогда дерево строится и
+	 * сохраняется в кэше). В остальных случаях возвращает nullptr.
+	*/
+	const tree *cached_tree(int v, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция, подготавливающая ответ на запрос (v, w). Возвращает
+	 * стоимость кратчайшего пути, в p записывает указатель на массив предков
+	 * (буфер поиска либо дерево из кэша), по которому восстанавливается путь.
+	 * Если поиск прерван, возвращает INF_COST.
+	*/
+	int search(int v, int w, const vector<int> *&p, SearchControl *control);
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; cache_capacity - максимальное количество деревьев кратчайших путей
+	 * в кэше (0 - кэш отключен); hot_threshold - количество запросов из вершины,
+	 * после которого для нее строится и кэшируется полное дерево.
+	*/
+	DijkstraSearcher(const Graph &G, int cache_capacity = 0, int hot_threshold = 2);
+
+	/*
+	 * Функция возвращает стоимость кратчайшего пути из вершины v в вершину w
+	 * либо INF_COST, если пути не существует или поиск прерван по control.
+	*/
+	int distance(int v, int w, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+	 * w и его стоимостью в формате: "v-k1-k2-...-kn-w, P" (см. ShortestPathSearcher).
+	 * Если пути не существует (или поиск прерван по control), возвращается строка
+	 * "v-w, inf".
+	*/
+	string get_path(int v, int w, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает количество вершин, окончательно обработанных последним
+	 * выполненным поиском (для сравнения с AltSearcher и другими поисками).
+	*/
+	inline int last_settled() const;
+
+	/* Функция очистки кэша деревьев кратчайших путей. */
+	void clear_cache();
+
+	/* Функция возвращает статистику последнего вызова distance() или get_path(). */
+	inline const Stats &statistics() const;
+};
+
+#endif // _DIJKSTRA_SEARCHER_
\ No newline at end of file
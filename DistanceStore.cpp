@@ -0,0 +1,220 @@
+#include "DistanceStore.hpp"
+
+// Вспомогательная функция вычисления индекса пары (v, w) в матрице стоимостей.
+// Для симметричной матрицы хранится верхний треугольник по строкам: строка v
+// содержит элементы (v, v), ..., (v, V - 1) и начинается с индекса
+// V + (V - 1) + ... + (V - v + 1) = v * (2V - v + 1) / 2.
+size_t DistanceStore::dist_index(int v, int w) const {
+	if(!h.symmetric)
+		return (size_t)v * h.v_cnt + w;
+	if(v > w)
+		swap(v, w);
+	return (size_t)v * (2 * (size_t)h.v_cnt - v + 1) / 2 + (w - v);
+}
+
+// Вспомогательная функция освобождения данных хранилища.
+void DistanceStore::release() {
+	if(mapped)
+		munmap(mapped, mapped_size);
+	mapped = nullptr;
+	mapped_size = 0;
+	vector<char>().swap(own);
+	dist_data = pred_data = nullptr;
+}
+
+// Вспомогательная функция размещения хранилища в векторе own. Матрица стоимостей
+// следует сразу за заголовком, матрица предшественников - за ней с выравниванием
+// на 8 байт.
+size_t DistanceStore::allocate() {
+	size_t n = h.v_cnt, dist_cnt = h.symmetric ? n * (n + 1) / 2 : n * n;
+	h.pred_offset = (sizeof(header) + dist_cnt * h.dist_bytes + 7) / 8 * 8;
+	own.assign(h.pred_offset + n * n * h.pred_bytes, 0);
+	memcpy(own.data(), &h, sizeof(header));
+	bind(own.data());
+	return own.size();
+}
+
+// Вспомогательная функция установки указателей на матрицы по заголовку.
+void DistanceStore::bind(const char *base) {
+	dist_data = base + sizeof(header);
+	pred_data = base + h.pred_offset;
+}
+
+// Конструктор. Создает пустое хранилище.
+DistanceStore::DistanceStore() : mapped(nullptr), mapped_size(0), dist_data(nullptr), pred_data(nullptr) {
+	memset(&h, 0, sizeof(header));
+}
+
+// Конструктор. Первый проход по матрице стоимостей определяет диапазон конечных
+// стоимостей и тем самым ширину элементов, второй - заполняет матрицы.
+template<typename Graph, typename Searcher>
+DistanceStore::DistanceStore(const Graph &G, const Searcher &S) :
+	mapped(nullptr), mapped_size(0), dist_data(nullptr), pred_data(nullptr)
+{
+	int n = G.V(), lo = 0, hi = 0;
+	bool sym = !G.directed();
+	for(int v = 0; v < n; ++v)
+		for(int w = (sym ? v : 0); w < n; ++w) {
+			int d = S.distance(v, w);
+			if(d != INF_COST) {
+				lo = min(lo, d);
+				hi = max(hi, d);
+			}
+		}
+
+	memset(&h, 0, sizeof(header));
+	memcpy(h.magic, "DST2", 4);
+	h.v_cnt = n;
+	h.e_cnt = G.E();
+	h.symmetric = sym;
+	h.dist_bytes = (lo >= INT16_MIN && hi < INT16_MAX ? 2 : 4);
+	h.pred_bytes = (n < UINT8_MAX ? 1 : n < UINT16_MAX ? 2 : 4);
+	h.checksum = CsrGraph(G).checksum();
+	allocate();
+
+	char *dist_out = own.data() + sizeof(header), *pred_out = own.data() + h.pred_offset;
+	for(int v = 0; v < n; ++v)
+		for(int w = (sym ? v : 0); w < n; ++w) {
+			int d = S.distance(v, w);
+			if(h.dist_bytes == 2)
+				((int16_t *)dist_out)[dist_index(v, w)] = (d == INF_COST ? INT16_MAX : d);
+			else
+				((int32_t *)dist_out)[dist_index(v, w)] = d;
+		}
+	for(int v = 0; v < n; ++v)
+		for(int w = 0; w < n; ++w) {
+			int p = S.predecessor(v, w);
+			size_t i = (size_t)v * n + w;
+			if(h.pred_bytes == 1)
+				((uint8_t *)pred_out)[i] = (p == -1 ? UINT8_MAX : p);
+			else if(h.pred_bytes == 2)
+				((uint16_t *)pred_out)[i] = (p == -1 ? UINT16_MAX : p);
+			else
+				((int32_t *)pred_out)[i] = p;
+		}
+}
+
+// Деструктор.
+DistanceStore::~DistanceStore() { release(); }
+
+// Функция сохранения хранилища в файл. Файл - точная копия данных хранилища
+// (заголовок с сигнатурой "DST2" и матрицы), поэтому может быть отображен в
+// память без преобразований.
+bool DistanceStore::save(const string &filename) const {
+	if(!dist_data)
+		return false;
+	ofstream fout(filename, ios::binary);
+	if(!fout.is_open())
+		return false;
+	fout.write(dist_data - sizeof(header), bytes());
+	return fout.good();
+}
+
+// Функция загрузки хранилища из файла отображением в память. Заголовок проверяется
+// до замены текущих данных, поэтому при ошибке хранилище не изменяется.
+bool DistanceStore::load(const string &filename) {
+	int fd = open(filename.c_str(), O_RDONLY);
+	if(fd == -1)
+		return false;
+	struct stat st;
+	if(fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(header)) {
+		close(fd);
+		return false;
+	}
+	size_t size = st.st_size;
+	void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(p == MAP_FAILED)
+		return false;
+
+	header hf;
+	memcpy(&hf, p, sizeof(header));
+	size_t n = hf.v_cnt, dist_cnt = hf.symmetric ? n * (n + 1) / 2 : n * n;
+	if(memcmp(hf.magic, "DST2", 4) != 0 || hf.v_cnt < 0 ||
+			(hf.dist_bytes != 2 && hf.dist_bytes != 4) ||
+			(hf.pred_bytes != 1 && hf.pred_bytes != 2 && hf.pred_bytes != 4) ||
+			hf.pred_offset != (int64_t)((sizeof(header) + dist_cnt * hf.dist_bytes + 7) / 8 * 8) ||
+			size < hf.pred_offset + n * n * hf.pred_bytes) {
+		munmap(p, size);
+		return false;
+	}
+
+	release();
+	h = hf;
+	mapped = p;
+	mapped_size = size;
+	bind((const char *)p);
+	return true;
+}
+
+// Функция проверки соответствия хранилища графу G. Контрольная сумма вычисляется
+// по CSR-представлению G только после совпадения размеров.
+template<typename Graph>
+bool DistanceStore::matches(const Graph &G) const {
+	return dist_data && h.v_cnt == G.V() && h.e_cnt == G.E() && (bool)h.symmetric == !G.directed() &&
+		h.checksum == CsrGraph(G).checksum();
+}
+
+// Функции возвращают количество вершин и ребер графа.
+int DistanceStore::V() const { return h.v_cnt; }
+
+int DistanceStore::E() const { return h.e_cnt; }
+
+// Функции возвращают ширину элементов матриц в байтах.
+int DistanceStore::distance_bytes() const { return h.dist_bytes; }
+
+int DistanceStore::predecessor_bytes() const { return h.pred_bytes; }
+
+// Функция возвращает общий объем данных хранилища в байтах.
+size_t DistanceStore::bytes() const {
+	return dist_data ? h.pred_offset + (size_t)h.v_cnt * h.v_cnt * h.pred_bytes : 0;
+}
+
+// Функция возвращает стоимость кратчайшего пути от вершины v до вершины w
+// либо INF_COST, если пути не существует.
+int DistanceStore::distance(int v, int w) const {
+	if(h.dist_bytes == 2) {
+		int16_t d = ((const int16_t *)dist_data)[dist_index(v, w)];
+		return d == INT16_MAX ? INF_COST : d;
+	}
+	return ((const int32_t *)dist_data)[dist_index(v, w)];
+}
+
+// Функция возвращает вершину, предшествующую w на кратчайшем пути от v.
+int DistanceStore::predecessor(int v, int w) const {
+	size_t i = (size_t)v * h.v_cnt + w;
+	if(h.pred_bytes == 1) {
+		uint8_t p = ((const uint8_t *)pred_data)[i];
+		return p == UINT8_MAX ? -1 : p;
+	}
+	if(h.pred_bytes == 2) {
+		uint16_t p = ((const uint16_t *)pred_data)[i];
+		return p == UINT16_MAX ? -1 : p;
+	}
+	return ((const int32_t *)pred_data)[i];
+}
+
+// Функция записывает кратчайший путь от вершины v до вершины w в буфер buf
+// (см. PathTracer::from_predecessors()).
+int DistanceStore::path(int v, int w, int *buf, int capacity) const {
+	if(distance(v, w) == INF_COST)
+		return 0;
+	return PathTracer::from_predecessors([&](int u) { return predecessor(v, u); }, v, w, buf, capacity);
+}
+
+// Функция возвращает кратчайший путь от вершины v до вершины w в виде вектора.
+vector<int> DistanceStore::path(int v, int w) const {
+	vector<int> res;
+	if(distance(v, w) != INF_COST)
+		PathTracer::from_predecessors([&](int u) { return predecessor(v, u); }, v, w, res);
+	return res;
+}
+
+// Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+// w и его стоимостью в формате: "v-k1-k2-...-kn-w, P".
+string DistanceStore::get_path(int v, int w) const {
+	int d = distance(v, w);
+	if(d == INF_COST)
+		return PathTracer::format(v, w);
+	return PathTracer::format(path(v, w), d);
+}
@@ -0,0 +1,151 @@
+#ifndef _DISTANCE_STORE_
+#define _DISTANCE_STORE_
+
+#include "main_header.hpp"
+#include "PathTracer.hpp"
+#include "CsrGraph.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Компактное хранилище результатов поиска кратчайших путей между всеми парами
+ * вершин: матрицы стоимостей путей и предшественников.
+ * ~~~~ Примечания:
+ * Строится по любому классу поиска, предоставляющему методы distance(v, w) и
+ * predecessor(v, w) (ShortestPathSearcher, AllPairsSearcher). Ширина элементов
+ * выбирается по данным: стоимости хранятся 16-битными числами, если все конечные
+ * стоимости помещаются в int16_t, иначе 32-битными; предшественники - 8-, 16- или
+ * 32-битными номерами вершин в зависимости от V. Отсутствие пути и отсутствие
+ * предшественника обозначаются максимальным значением соответствующего типа.
+ * Для неориентированного графа матрица стоимостей симметрична, поэтому хранится
+ * только ее верхний треугольник (с диагональю); матрица предшественников хранится
+ * полностью, так как предшественники на путях v-w и w-v различны.
+ * Хранилище сохраняется в двоичный файл (save()) и загружается из него отображением
+ * в память (load(), mmap): данные не копируются и подгружаются с диска страницами
+ * по мере обращения, поэтому повторный запуск не требует пересчета путей.
+ * Заголовок содержит контрольную сумму дуг графа (см. CsrGraph::checksum()),
+ * поэтому matches() отличает граф с теми же V и E, но другими дугами или
+ * стоимостями.
+*/
+class DistanceStore {
+private:
+	/* Заголовок файла (и хранилища в памяти). Размер кратен 8 байтам. */
+	struct header {
+		char magic[4];
+		int32_t v_cnt, e_cnt, symmetric, dist_bytes, pred_bytes;
+		int64_t pred_offset;
+		/* Контрольная сумма графа (см. CsrGraph::checksum()). */
+		uint64_t checksum;
+	};
+
+	header h;
+	/* Данные хранилища: заголовок, матрица стоимостей, матрица предшественников. */
+	vector<char> own;
+	/* Отображение файла в память (nullptr, если данные хранятся в own). */
+	void *mapped;
+	size_t mapped_size;
+	const char *dist_data, *pred_data;
+
+	/* Вспомогательная функция вычисления индекса пары (v, w) в матрице стоимостей. */
+	inline size_t dist_index(int v, int w) const;
+
+	/* Вспомогательная функция освобождения данных (в том числе отображения). */
+	void release();
+
+	/*
+	 * Вспомогательная функция размещения хранилища в векторе own по заполненному
+	 * заголовку h. Возвращает размер данных.
+	*/
+	size_t allocate();
+
+	/* Вспомогательная функция установки указателей dist_data и pred_data по заголовку. */
+	void bind(const char *base);
+public:
+	/* Конструктор. Создает пустое хранилище (см. load()). */
+	DistanceStore();
+
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; S - класс поиска, вычисливший кратчайшие пути между всеми парами
+	 * вершин графа G (методы distance() и predecessor()).
+	*/
+	template<typename Graph, typename Searcher>
+	DistanceStore(const Graph &G, const Searcher &S);
+
+	/* Деструктор. Освобождает отображение файла в память. */
+	~DistanceStore();
+
+	/* Копирование запрещено: хранилище может владеть отображением файла. */
+	DistanceStore(const DistanceStore &) = delete;
+	DistanceStore &operator=(const DistanceStore &) = delete;
+
+	/* Функция сохранения хранилища в файл. Возвращает false при ошибке. */
+	bool save(const string &filename) const;
+
+	/*
+	 * Функция загрузки хранилища из файла отображением в память. Возвращает false,
+	 * если файл не удалось открыть или он имеет неверный формат.
+	*/
+	bool load(const string &filename);
+
+	/*
+	 * Функция проверки соответствия хранилища графу G (по количеству вершин, ребер,
+	 * ориентированности и контрольной сумме дуг). Используется после load().
+	*/
+	template<typename Graph>
+	bool matches(const Graph &G) const;
+
+	/* Функции возвращают количество вершин и ребер графа, для которого построено хранилище. */
+	inline int V() const;
+	inline int E() const;
+
+	/* Функции возвращают ширину (в байтах) элементов матриц стоимостей и предшественников. */
+	inline int distance_bytes() const;
+	inline int predecessor_bytes() const;
+
+	/* Функция возвращает общий объем данных хранилища в байтах. */
+	inline size_t bytes() const;
+
+	/*
+	 * Функция возвращает стоимость кратчайшего пути от вершины v до вершины w
+	 * либо INF_COST, если пути не существует.
+	*/
+	inline int distance(int v, int w) const;
+
+	/*
+	 * Функция возвращает вершину, предшествующую вершине w на кратчайшем пути от
+	 * вершины v, либо -1, если пути не существует или v == w.
+	*/
+	inline int predecessor(int v, int w) const;
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция записывает кратчайший путь от вершины v до вершины w (номера вершин
+	 * v, k1, ..., kn, w) в буфер buf емкостью capacity (см. PathTracer).
+	 * ~~~~ Примечания:
+	 * Возвращает количество вершин пути, 0, если пути не существует, либо -1, если
+	 * путь не помещается в буфер. Память не выделяет.
+	*/
+	int path(int v, int w, int *buf, int capacity) const;
+
+	/*
+	 * Функция возвращает кратчайший путь от вершины v до вершины w в виде вектора
+	 * номеров вершин v, k1, ..., kn, w (пустой вектор, если пути не существует).
+	*/
+	vector<int> path(int v, int w) const;
+
+	/*
+	 * Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
+	 * w и его стоимостью в формате: "v-k1-k2-...-kn-w, P" (см. ShortestPathSearcher).
+	*/
+	string get_path(int v, int w) const;
+};
+
+#endif // _DISTANCE_STORE_
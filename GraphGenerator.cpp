@@ -0,0 +1,116 @@
+#include "GraphGenerator.hpp"
+
+// Вспомогательная функция, возвращающая случайное число из [0, n). Остаток от
+// деления (в отличие от uniform_int_distribution) дает одинаковую
+// последовательность во всех реализациях стандартной библиотеки.
+unsigned long long GraphGenerator::below(mt19937_64 &rng, unsigned long long n) {
+	return rng() % n;
+}
+
+// Случайный граф G(V, E).
+void GraphGenerator::erdos_renyi(vector<Edge> &edges, int V, long long E,
+		unsigned long long seed, int max_cost)
+{
+	if(V < 2)
+		return;
+	mt19937_64 rng(seed);
+	edges.reserve(edges.size() + E);
+	for(long long i = 0; i < E; ++i) {
+		int v = below(rng, V), w = below(rng, V - 1);
+		w += (w >= v);
+		edges.push_back(Edge(v, w, 1 + below(rng, max_cost)));
+	}
+}
+
+// Решетка rows x cols.
+void GraphGenerator::grid(vector<Edge> &edges, int rows, int cols, unsigned long long seed,
+		int max_cost)
+{
+	mt19937_64 rng(seed);
+	edges.reserve(edges.size() + 4LL * rows * cols);
+	for(int r = 0; r < rows; ++r)
+		for(int c = 0; c < cols; ++c) {
+			int v = r * cols + c;
+			if(c + 1 < cols) {
+				int cost = 1 + below(rng, max_cost);
+				edges.push_back(Edge(v, v + 1, cost));
+				edges.push_back(Edge(v + 1, v, cost));
+			}
+			if(r + 1 < rows) {
+				int cost = 1 + below(rng, max_cost);
+				edges.push_back(Edge(v, v + cols, cost));
+				edges.push_back(Edge(v + cols, v, cost));
+			}
+		}
+}
+
+// Степенной граф R-MAT. На каждом из scale уровней выбирается четверть матрицы
+// смежности: бит номера строки (v) и бит номера столбца (w).
+void GraphGenerator::rmat(vector<Edge> &edges, int scale, long long E, unsigned long long seed,
+		int max_cost, double a, double b, double c)
+{
+	mt19937_64 rng(seed);
+	const double unit = 1.0 / 18446744073709551616.0;	// 2^-64
+	edges.reserve(edges.size() + E);
+	for(long long i = 0; i < E; ++i) {
+		int v = 0, w = 0;
+		for(int bit = scale - 1; bit >= 0; --bit) {
+			double p = rng() * unit;
+			if(p >= a + b + c)
+				v |= 1 << bit, w |= 1 << bit;
+			else if(p >= a + b)
+				v |= 1 << bit;
+			else if(p >= a)
+				w |= 1 << bit;
+		}
+		int cost = 1 + below(rng, max_cost);
+		if(v != w)
+			edges.push_back(Edge(v, w, cost));
+	}
+}
+
+// Многослойный ациклический граф.
+void GraphGenerator::layered_dag(vector<Edge> &edges, int layers, int width, int degree,
+		unsigned long long seed, int max_cost)
+{
+	mt19937_64 rng(seed);
+	edges.reserve(edges.size() + (long long)max(layers - 1, 0) * width * degree);
+	for(int l = 0; l + 1 < layers; ++l)
+		for(int i = 0; i < width; ++i)
+			for(int d = 0; d < degree; ++d) {
+				int w = (l + 1) * width + below(rng, width);
+				edges.push_back(Edge(l * width + i, w, 1 + below(rng, max_cost)));
+			}
+}
+
+// Цепочка 0 -> 1 -> ... -> V - 1.
+void GraphGenerator::chain(vector<Edge> &edges, int V, unsigned long long seed, int max_cost) {
+	mt19937_64 rng(seed);
+	edges.reserve(edges.size() + max(V - 1, 0));
+	for(int v = 0; v + 1 < V; ++v)
+		edges.push_back(Edge(v, v + 1, 1 + below(rng, max_cost)));
+}
+
+// Функция записи дуг в формате матрицы смежности: V строк по V чисел.
+string GraphGenerator::to_matrix(const vector<Edge> &edges, int V) {
+	vector<int> m((size_t)V * V, 0);
+	for(auto &e : edges)
+		if(m[(size_t)e.v * V + e.w] == 0)
+			m[(size_t)e.v * V + e.w] = e.c;
+	string res;
+	for(int i = 0; i < V; ++i) {
+		for(int j = 0; j < V; ++j) {
+			res += to_string(m[(size_t)i * V + j]);
+			res += (j + 1 < V ? ' ' : '\n');
+		}
+	}
+	return res;
+}
+
+// Функция записи дуг в формате списка "v-w, c;".
+string GraphGenerator::to_list(const vector<Edge> &edges) {
+	string res;
+	for(auto &e : edges)
+		res += to_string(e.v) + "-" + to_string(e.w) + ", " + to_string(e.c) + ";\n";
+	return res;
+}
@@ -0,0 +1,70 @@
+#ifndef _GRAPH_GENERATOR_
+#define _GRAPH_GENERATOR_
+
+#include "main_header.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Набор статических функций построения синтетических графов для тестирования и
+ * измерения производительности: случайный граф Эрдёша-Реньи, двумерная решетка,
+ * степенной граф R-MAT, многослойный ациклический граф и цепочка.
+ * ~~~~ Примечания:
+ * Функции записывают дуги графа в вектор edges (как scan_edges() классов графов),
+ * стоимости дуг - случайные числа от 1 до max_cost. Генерация детерминирована:
+ * при одинаковых параметрах и seed результат одинаков на любой платформе
+ * (используется mt19937_64 без библиотечных распределений). Ребра решетки
+ * добавляются в обоих направлениях; остальные графы ориентированные. Функции
+ * to_matrix() и to_list() записывают дуги в текстовых форматах DenseGraph и
+ * SparseGraph (для измерения чтения графа).
+*/
+class GraphGenerator {
+private:
+	/* Вспомогательная функция, возвращающая случайное число из [0, n). */
+	static inline unsigned long long below(mt19937_64 &rng, unsigned long long n);
+public:
+	/*
+	 * Случайный граф G(V, E): E дуг между случайными различными вершинами
+	 * (повторяющиеся дуги возможны, классы графов сохраняют первую из них).
+	*/
+	static void erdos_renyi(vector<Edge> &edges, int V, long long E, unsigned long long seed,
+		int max_cost = 100);
+
+	/*
+	 * Решетка rows x cols: вершина r * cols + c соединена с соседями по строке и
+	 * столбцу ребрами в обоих направлениях (с одинаковой стоимостью).
+	*/
+	static void grid(vector<Edge> &edges, int rows, int cols, unsigned long long seed,
+		int max_cost = 100);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Степенной граф R-MAT с 2^scale вершинами и E дугами.
+	 * ~~~~ Примечания:
+	 * Каждая дуга выбирается рекурсивным делением матрицы смежности на четверти с
+	 * вероятностями a, b, c и 1 - a - b - c (по умолчанию параметры Graph500).
+	 * Петли пропускаются.
+	*/
+	static void rmat(vector<Edge> &edges, int scale, long long E, unsigned long long seed,
+		int max_cost = 100, double a = 0.57, double b = 0.19, double c = 0.19);
+
+	/*
+	 * Многослойный ациклический граф: layers слоев по width вершин, каждая вершина
+	 * (кроме последнего слоя) соединена с degree случайными вершинами следующего
+	 * слоя. Вершина 0 - в первом слое, вершина layers * width - 1 - в последнем.
+	*/
+	static void layered_dag(vector<Edge> &edges, int layers, int width, int degree,
+		unsigned long long seed, int max_cost = 100);
+
+	/* Цепочка 0 -> 1 -> ... -> V - 1. */
+	static void chain(vector<Edge> &edges, int V, unsigned long long seed, int max_cost = 100);
+
+	/*
+	 * Функции записи дуг edges графа с V вершинами в текстовом формате
+	 * DenseGraph::scan_edges() (матрица смежности) и SparseGraph::scan_edges()
+	 * (список "v-w, c;"). Из повторяющихся дуг в матрицу попадает первая.
+	*/
+	static string to_matrix(const vector<Edge> &edges, int V);
+	static string to_list(const vector<Edge> &edges);
+};
+
+#endif // _GRAPH_GENERATOR_
@@ -0,0 +1,21 @@
+#include "GraphObserver.hpp"
+
+// Функция подписки наблюдателя o. Повторная подписка игнорируется.
+void GraphObservers::subscribe(GraphObserver *o) const {
+	if(find(observers.begin(), observers.end(), o) == observers.end())
+		observers.push_back(o);
+}
+
+// Функция отписки наблюдателя o.
+void GraphObservers::unsubscribe(GraphObserver *o) const {
+	observers.erase(remove(observers.begin(), observers.end(), o), observers.end());
+}
+
+// Функция уведомления всех наблюдателей об изменении дуги (v, w). Обход выполняется
+// по индексу и только по наблюдателям, подписанным до начала уведомления: наблюдатель
+// может создать нового наблюдателя (подписка добавляет элемент в вектор), который
+// уже построен по измененному графу и уведомления не получает.
+void GraphObservers::notify(int v, int w, int old_c, int new_c) const {
+	for(size_t i = 0, n = observers.size(); i < n; ++i)
+		observers[i]->edge_changed(v, w, old_c, new_c);
+}
@@ -0,0 +1,57 @@
+#ifndef _GRAPH_OBSERVER_
+#define _GRAPH_OBSERVER_
+
+#include "main_header.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Абстрактный класс наблюдателя изменений графа. Классы поиска, хранящие
+ * предварительно вычисленные данные, подписываются на изменения графа (см.
+ * GraphObservers) и обновляют эти данные без полного перестроения.
+ * ~~~~ Примечания:
+ * Метод edge_changed() вызывается для каждой дуги отдельно: в неориентированном
+ * графе добавление (удаление) ребра порождает два вызова - для дуги (v, w) и для
+ * дуги (w, v). Вызов выполняется сразу после изменения дуги, поэтому на момент
+ * вызова граф отличается от состояния, известного наблюдателю, ровно на эту дугу.
+ * В edge_changed() можно подписывать на граф новых наблюдателей (они не получают
+ * текущего уведомления), но нельзя отписывать наблюдателей.
+*/
+class GraphObserver {
+public:
+	virtual ~GraphObserver() { }
+
+	/*
+	 * Функция, вызываемая графом после изменения стоимости дуги из вершины v в
+	 * вершину w с old_c на new_c. Значение 0 означает отсутствие дуги: добавлению
+	 * дуги соответствует old_c == 0, удалению - new_c == 0.
+	*/
+	virtual void edge_changed(int v, int w, int old_c, int new_c) = 0;
+};
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Список наблюдателей графа. Используется как поле классов графов (DenseGraph,
+ * SparseGraph).
+ * ~~~~ Примечания:
+ * Подписка не изменяет сам граф, поэтому методы subscribe() и unsubscribe()
+ * константны (список хранится в mutable-поле) и доступны классам поиска, которые
+ * получают граф по константной ссылке. При копировании графа подписки не
+ * копируются: наблюдатель следит только за тем графом, на который подписался.
+*/
+class GraphObservers {
+private:
+	mutable vector<GraphObserver *> observers;
+public:
+	GraphObservers() { }
+	GraphObservers(const GraphObservers &) { }
+	GraphObservers &operator=(const GraphObservers &) { return *this; }
+
+	/* Функции подписки и отписки наблюдателя o. */
+	void subscribe(GraphObserver *o) const;
+	void unsubscribe(GraphObserver *o) const;
+
+	/* Функция уведомления всех наблюдателей об изменении дуги (v, w). */
+	void notify(int v, int w, int old_c, int new_c) const;
+};
+
+#endif // _GRAPH_OBSERVER_
@@ -0,0 +1,176 @@
+#include "KShortestSearcher.hpp"
+
+// Вспомогательная функция поиска Дейкстры из s в t. Буферы сбрасываются только для
+// вершин, затронутых предыдущим поиском; поиск останавливается при извлечении t.
+template<typename Graph, typename Stats>
+int KShortestSearcher<Graph, Stats>::dijkstra(int s, int t) {
+	stats.begin(QueryStats::SEARCH);
+	for(int u : touched) {
+		dist[u] = INF_COST;
+		parent[u] = -1;
+	}
+	touched.clear();
+	heap.clear();
+	++searches;
+
+	dist[s] = 0;
+	touched.push_back(s);
+	heap.push(s, 0);
+	while(!heap.empty()) {
+		if(control && !control->step())
+			return INF_COST;
+		int u = heap.pop();
+		stats.expand();
+		if(u == t)
+			break;
+		stats.scan(G.last(u) - G.first(u));
+		for(int i = G.first(u); i < G.last(u); ++i) {
+			int x = G.target(i), d = dist[u] + G.cost(i);
+			if(banned[i] == stamp || blocked[x] == stamp || d >= dist[x])
+				continue;
+			if(dist[x] == INF_COST)
+				touched.push_back(x);
+			dist[x] = d;
+			parent[x] = u;
+			heap.push(x, d);
+		}
+	}
+	return dist[t];
+}
+
+// Вспомогательная функция, возвращающая индекс дуги (u, x). Списки смежных вершин
+// CsrGraph упорядочены, поэтому используется двоичный поиск.
+template<typename Graph, typename Stats>
+int KShortestSearcher<Graph, Stats>::arc(int u, int x) const {
+	int lo = G.first(u), hi = G.last(u);
+	while(lo < hi) {
+		int mid = (lo + hi) / 2;
+		if(G.target(mid) < x)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return (lo < G.last(u) && G.target(lo) == x ? lo : -1);
+}
+
+// Конструктор.
+template<typename Graph, typename Stats>
+KShortestSearcher<Graph, Stats>::KShortestSearcher(const Graph &graph) :
+	G(graph), v_cnt(graph.V()), dist(graph.V(), INF_COST), parent(graph.V(), -1),
+	heap(graph.V()), blocked(graph.V(), 0), banned(G.E(), 0), stamp(0), searches(0),
+	control(nullptr) { }
+
+// Функция поиска k кратчайших простых путей (алгоритм Йена с улучшением Лоулера).
+// dev[j] - индекс вершины, в которой j-й найденный путь отклонился от родительского.
+// Для спур-вершины P[i] исключаются вершины P[0..i) (путь остается простым) и
+// дуги (P[i], q[i + 1]) всех найденных путей q с началом P[0..i] (чтобы не
+// повторить найденные пути). Повторяющиеся кандидаты отбрасываются. После
+// остановки по control в found остаются пути, найденные до нее.
+template<typename Graph, typename Stats>
+void KShortestSearcher<Graph, Stats>::yen(int v, int w, int k, vector<result> &found) {
+	stats.begin(QueryStats::SETUP);
+	searches = 0;
+	if(v < 0 || w < 0 || v >= v_cnt || w >= v_cnt || k <= 0)
+		return;
+
+	++stamp;
+	int d = dijkstra(v, w);
+	if(d == INF_COST)
+		return;
+	stats.begin(QueryStats::RECONSTRUCTION);
+	found.push_back({d, {}});
+	PathTracer::from_predecessors([&](int u) { return parent[u]; }, v, w, found[0].path);
+	stats.path();
+	stats.allocate(found[0].path.size() * sizeof(int));
+	if(control && !control->found())
+		return;
+
+	vector<int> dev(1, 0), cand_dev;
+	vector<result> cand;
+	set<vector<int>> seen;
+	seen.insert(found[0].path);
+	priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> best;
+
+	while((int)found.size() < k) {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		const vector<int> P = found.back().path;
+		// prefix[i] - стоимость начала пути P[0..i].
+		vector<int> prefix(P.size(), 0);
+		for(size_t i = 1; i < P.size(); ++i)
+			prefix[i] = prefix[i - 1] + G.cost(arc(P[i - 1], P[i]));
+
+		for(int i = dev.back(); i + 1 < (int)P.size(); ++i) {
+			++stamp;
+			for(int j = 0; j < i; ++j)
+				blocked[P[j]] = stamp;
+			for(auto &q : found)
+				if((int)q.path.size() > i + 1 && equal(P.begin(), P.begin() + i + 1, q.path.begin()))
+					banned[arc(P[i], q.path[i + 1])] = stamp;
+
+			int spur = dijkstra(P[i], w);
+			if(control && control->stopped())
+				return;
+			stats.begin(QueryStats::RECONSTRUCTION);
+			if(spur == INF_COST)
+				continue;
+			vector<int> path(P.begin(), P.begin() + i), tail;
+			PathTracer::from_predecessors([&](int u) { return parent[u]; }, P[i], w, tail);
+			path.insert(path.end(), tail.begin(), tail.end());
+			if(!seen.insert(path).second)
+				continue;
+			best.push({prefix[i] + spur, (int)cand.size()});
+			stats.allocate(path.size() * sizeof(int));
+			cand.push_back({prefix[i] + spur, move(path)});
+			cand_dev.push_back(i);
+		}
+
+		if(best.empty())
+			break;
+		int id = best.top().second;
+		best.pop();
+		found.push_back(move(cand[id]));
+		dev.push_back(cand_dev[id]);
+		stats.path();
+		if(control && !control->found())
+			break;
+	}
+}
+
+// Функция поиска k кратчайших простых путей.
+template<typename Graph, typename Stats>
+vector<typename KShortestSearcher<Graph, Stats>::result> KShortestSearcher<Graph, Stats>::paths(
+		int v, int w, int k, SearchControl *ctl)
+{
+	vector<result> found;
+	stats.reset();
+	control = ctl;
+	yen(v, w, k, found);
+	stats.end();
+	return found;
+}
+
+// Функция возвращает k кратчайших простых путей в формате DeepSearcher::get_paths().
+template<typename Graph, typename Stats>
+vector<string> KShortestSearcher<Graph, Stats>::get_paths(int v, int w, int k, SearchControl *ctl) {
+	vector<result> found;
+	stats.reset();
+	control = ctl;
+	yen(v, w, k, found);
+
+	stats.begin(QueryStats::FORMATTING);
+	vector<string> res;
+	for(auto &r : found) {
+		res.push_back(PathTracer::format_simple(r.path, r.cost));
+		stats.allocate(res.back().size());
+	}
+	stats.end();
+	return res;
+}
+
+// Функция возвращает количество поисков Дейкстры, выполненных последним запросом.
+template<typename Graph, typename Stats>
+int KShortestSearcher<Graph, Stats>::last_searches() const { return searches; }
+
+// Функция возвращает статистику последнего запроса.
+template<typename Graph, typename Stats>
+const Stats &KShortestSearcher<Graph, Stats>::statistics() const { return stats; }
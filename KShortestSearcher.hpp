@@ -0,0 +1,103 @@
+#ifndef _K_SHORTEST_SEARCHER_
+#define _K_SHORTEST_SEARCHER_
+
+#include "main_header.hpp"
+#include "CsrGraph.hpp"
+#include "DaryHeap.hpp"
+#include "PathTracer.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+#include <set>
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс поиска K кратчайших простых путей (без повторяющихся вершин)
+ * между двумя вершинами графа Graph в порядке возрастания стоимости (алгоритм Йена).
+ * ~~~~ Примечания:
+ * Очередной путь ищется как отклонение от уже найденного пути P: для каждой
+ * вершины P[i] (спур-вершины) из графа исключаются вершины P[0..i) и дуги,
+ * которыми найденные пути с тем же началом P[0..i] продолжаются из P[i], и
+ * поиском Дейкстры строится кратчайший путь из P[i] в w. Кандидаты хранятся в
+ * куче; наименьший из них - следующий путь. Спур-вершины перед вершиной, в
+ * которой P отклонился от своего родительского пути, пропускаются (улучшение
+ * Лоулера): их кандидаты уже построены при обработке родительского пути. Итого
+ * выполняется O(K * L) поисков (L - длина пути), независимо от общего количества
+ * простых путей. Исключение вершин и дуг задается метками без изменения графа;
+ * буферы поиска и куча выделяются один раз и переиспользуются.
+ * Запрос можно прервать (см. SearchControl): извлечение вершины из кучи
+ * засчитывается как шаг, каждый найденный путь - как результат; прерванный
+ * запрос возвращает пути, найденные до остановки.
+ * Stats - политика статистики запросов (см. NoStats, CountingStats): каждый вызов
+ * paths() и get_paths() сбрасывает статистику и учитывает вершины, извлеченные
+ * всеми поисками Дейкстры, просмотренные ими дуги, найденные пути и время этапов
+ * (поиск - поиски Дейкстры, восстановление - построение путей-кандидатов).
+ * Стоимости ребер графа должны быть неотрицательными. Экземпляр не предназначен
+ * для одновременного использования из нескольких потоков.
+*/
+template<typename Graph, typename Stats = NoStats>
+class KShortestSearcher {
+public:
+	/* Найденный путь: стоимость и вершины v, k1, ..., kn, w. */
+	struct result {
+		int cost;
+		vector<int> path;
+	};
+private:
+	CsrGraph G;
+	int v_cnt;
+
+	/* Переиспользуемые буферы поиска Дейкстры. */
+	vector<int> dist, parent, touched;
+	DaryHeap<4> heap;
+	/*
+	 * Метки исключения: вершина v исключена, если blocked[v] == stamp, дуга с
+	 * индексом i - если banned[i] == stamp.
+	*/
+	vector<int> blocked, banned;
+	int stamp;
+	/* Количество поисков Дейкстры, выполненных последним запросом. */
+	int searches;
+	/* Управление текущим запросом (nullptr - без ограничений). */
+	SearchControl *control;
+	/* Статистика последнего запроса. */
+	Stats stats;
+
+	/*
+	 * Вспомогательная функция поиска Дейкстры из s в t без исключенных вершин и дуг.
+	 * Возвращает стоимость пути (INF_COST, если пути нет или поиск прерван); путь -
+	 * по массиву parent.
+	*/
+	int dijkstra(int s, int t);
+
+	/* Вспомогательная функция, возвращающая индекс дуги (u, x) в G либо -1. */
+	int arc(int u, int x) const;
+
+	/* Вспомогательная функция поиска путей (см. paths()) без сброса статистики. */
+	void yen(int v, int w, int k, vector<result> &found);
+public:
+	/* Конструктор. Строит CSR-представление графа G и буферы поиска. */
+	KShortestSearcher(const Graph &G);
+
+	/*
+	 * Функция возвращает не более k кратчайших простых путей из вершины v в
+	 * вершину w в порядке возрастания стоимости (пути равной стоимости - в порядке
+	 * нахождения). control - управление запросом (nullptr - без ограничений).
+	*/
+	vector<result> paths(int v, int w, int k, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает не более k кратчайших простых путей из вершины v в вершину
+	 * w в порядке возрастания стоимости в формате DeepSearcher::get_paths():
+	 * "-v-k1-k2-...-kn-w, costs".
+	*/
+	vector<string> get_paths(int v, int w, int k, SearchControl *control = nullptr);
+
+	/* Функция возвращает количество поисков Дейкстры, выполненных последним запросом. */
+	inline int last_searches() const;
+
+	/* Функция возвращает статистику последнего вызова paths() или get_paths(). */
+	inline const Stats &statistics() const;
+};
+
+#endif // _K_SHORTEST_SEARCHER_
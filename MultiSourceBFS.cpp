@@ -0,0 +1,133 @@
+#include "MultiSourceBFS.hpp"
+
+// Вспомогательная функция прохода для пакета стартовых вершин, начинающегося с
+// sources[first]. Каждый уровень выполняется в два шага:
+// 1) для каждой вершины фронта v и каждого ребра (v, u): next[u] |= visit[v];
+// 2) для каждой вершины u, получившей биты на шаге 1: новые биты
+// next[u] & ~seen[u] добавляются в seen[u] и образуют маску u в следующем фронте.
+// Вершина попадает в список touched при первом получении битов на уровне.
+// Обработка вершины фронта на шаге 1 засчитывается как шаг control; при остановке
+// сохраняются маски, достигнутые к этому моменту.
+template<typename Graph, int W, typename Stats>
+bool MultiSourceBFS<Graph, W, Stats>::run_batch(int first, SearchControl *control) {
+	int cnt = min((int)BATCH, (int)sources.size() - first);
+	vector<uint64_t> seen((size_t)v_cnt * W, 0), visit((size_t)v_cnt * W, 0),
+		next((size_t)v_cnt * W, 0);
+	vector<int> frontier, touched;
+	vector<char> in_next(v_cnt, 0);
+
+	for(int i = 0; i < cnt; ++i) {
+		int s = sources[first + i];
+		if(s < 0 || s >= v_cnt)
+			continue;
+		uint64_t bit = 1ULL << (i % 64);
+		if(!in_next[s]) {
+			in_next[s] = 1;
+			frontier.push_back(s);
+		}
+		seen[(size_t)s * W + i / 64] |= bit;
+		visit[(size_t)s * W + i / 64] |= bit;
+		if(store_hops)
+			hop[(size_t)s * sources.size() + first + i] = 0;
+	}
+	for(int s : frontier)
+		in_next[s] = 0;
+
+	for(int level = 1; !frontier.empty(); ++level) {
+		// Шаг 1: продвижение фронта по ребрам.
+		for(int v : frontier) {
+			if(control && !control->step()) {
+				reach.push_back(move(seen));
+				return false;
+			}
+			stats.expand();
+			stats.scan(G.last(v) - G.first(v));
+			const uint64_t *vv = &visit[(size_t)v * W];
+			for(int e = G.first(v); e < G.last(v); ++e) {
+				int u = G.target(e);
+				uint64_t *nu = &next[(size_t)u * W];
+				for(int k = 0; k < W; ++k)
+					nu[k] |= vv[k];
+				if(!in_next[u]) {
+					in_next[u] = 1;
+					touched.push_back(u);
+				}
+			}
+		}
+		for(int v : frontier)
+			fill(&visit[(size_t)v * W], &visit[(size_t)v * W] + W, 0);
+
+		// Шаг 2: отбор новых вершин и формирование следующего фронта.
+		frontier.clear();
+		for(int u : touched) {
+			in_next[u] = 0;
+			uint64_t *nu = &next[(size_t)u * W], *su = &seen[(size_t)u * W],
+				*vu = &visit[(size_t)u * W];
+			uint64_t any = 0;
+			for(int k = 0; k < W; ++k) {
+				vu[k] = nu[k] & ~su[k];
+				su[k] |= vu[k];
+				nu[k] = 0;
+				any |= vu[k];
+			}
+			if(!any)
+				continue;
+			frontier.push_back(u);
+			if(store_hops)
+				for(int k = 0; k < W; ++k)
+					for(uint64_t m = vu[k]; m; m &= m - 1) {
+						int i = k * 64 + __builtin_ctzll(m);
+						hop[(size_t)u * sources.size() + first + i] = level;
+					}
+		}
+		touched.clear();
+	}
+
+	reach.push_back(move(seen));
+	return true;
+}
+
+// Конструктор.
+template<typename Graph, int W, typename Stats>
+MultiSourceBFS<Graph, W, Stats>::MultiSourceBFS(const Graph &graph) :
+	G(graph), v_cnt(graph.V()), store_hops(false) { }
+
+// Основная функция: поиск из всех вершин src пакетами по BATCH вершин.
+template<typename Graph, int W, typename Stats>
+bool MultiSourceBFS<Graph, W, Stats>::run(const vector<int> &src, bool hops, SearchControl *control) {
+	stats.reset();
+	stats.begin(QueryStats::SETUP);
+	sources = src;
+	store_hops = hops;
+	hop.assign(hops ? sources.size() * (size_t)v_cnt : 0, -1);
+	stats.allocate(hop.size() * sizeof(int));
+	reach.clear();
+	stats.begin(QueryStats::SEARCH);
+	bool res = true;
+	for(int first = 0; res && first < (int)sources.size(); first += BATCH) {
+		res = run_batch(first, control);
+		stats.allocate(reach.back().size() * sizeof(uint64_t));
+	}
+	stats.end();
+	return res;
+}
+
+// Функция возвращает количество ребер в кратчайшем пути из i-й стартовой вершины в v.
+template<typename Graph, int W, typename Stats>
+int MultiSourceBFS<Graph, W, Stats>::hops(int i, int v) const {
+	return hop[(size_t)v * sources.size() + i];
+}
+
+// Функция проверки достижимости вершины v из i-й стартовой вершины. Пакеты, не
+// обработанные из-за остановки поиска, масок не имеют.
+template<typename Graph, int W, typename Stats>
+bool MultiSourceBFS<Graph, W, Stats>::reachable(int i, int v) const {
+	int b = i / BATCH, k = i % BATCH;
+	if(b >= (int)reach.size())
+		return false;
+	return (reach[b][(size_t)v * W + k / 64] >> (k % 64)) & 1;
+}
+
+// Функция возвращает статистику последнего вызова run().
+template<typename Graph, int W, typename Stats>
+const Stats &MultiSourceBFS<Graph, W, Stats>::statistics() const { return stats; }
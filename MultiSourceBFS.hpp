@@ -0,0 +1,89 @@
+#ifndef _MULTI_SOURCE_BFS_
+#define _MULTI_SOURCE_BFS_
+
+#include "main_header.hpp"
+#include "CsrGraph.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+#include <cstdint>
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Модульный класс поиска в ширину из многих вершин одновременно (MS-BFS) в графе
+ * Graph: вычисляет для каждой стартовой вершины количество ребер (переходов) в
+ * кратчайших по числу ребер путях до всех вершин либо только их достижимость.
+ * ~~~~ Примечания:
+ * Стартовые вершины обрабатываются пакетами по 64 * W: каждой вершине графа
+ * сопоставляются битовые маски из W 64-битных слов - "уже посещена" (seen) и
+ * "в текущем фронте" (visit), бит i соответствует i-й стартовой вершине пакета.
+ * Один просмотр ребра (v, u) продвигает фронт сразу всех поисков пакета:
+ * next[u] |= visit[v]. Новые вершины уровня - next[u] & ~seen[u]. При W = 4
+ * (256 поисков за проход) циклы по словам масок компилятор векторизует (AVX2).
+ * Фронт хранится списком вершин с ненулевой маской, поэтому проход выполняется
+ * за O(E * W) независимо от количества уровней.
+ * Поиск можно прервать (см. SearchControl): обработка вершины фронта засчитывается
+ * как шаг. После остановки результаты пакетов, обработанных полностью, точны, а в
+ * прерванном и необработанных пакетах недостигнутые вершины считаются недостижимыми.
+ * Stats - политика статистики (см. NoStats, CountingStats): run() сбрасывает
+ * статистику и учитывает обработанные вершины фронтов (по одной на вершину фронта
+ * пакета, а не на каждый из поисков), просмотренные дуги, память результата и
+ * время подготовки и поиска.
+*/
+template<typename Graph, int W = 1, typename Stats = NoStats>
+class MultiSourceBFS {
+private:
+	/* Количество стартовых вершин в одном пакете. */
+	static const int BATCH = 64 * W;
+
+	CsrGraph G;
+	int v_cnt;
+	bool store_hops;
+	vector<int> sources;
+	/*
+	 * hop[v * |sources| + i] - количество ребер в кратчайшем пути из sources[i] в v
+	 * (-1 - недостижима). Значения одной вершины для всех поисков хранятся подряд:
+	 * при обработке вершины записи попадают в одну область памяти.
+	*/
+	vector<int> hop;
+	/* reach[b][v * W + k] - маска "seen" вершины v после прохода для пакета b. */
+	vector<vector<uint64_t>> reach;
+
+	/* Статистика последнего вызова run(). */
+	Stats stats;
+
+	/*
+	 * Вспомогательная функция прохода для стартовых вершин sources[first, first + BATCH).
+	 * Возвращает false, если проход прерван по control.
+	*/
+	bool run_batch(int first, SearchControl *control);
+public:
+	/* Конструктор. Строит CSR-представление графа G. */
+	MultiSourceBFS(const Graph &G);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Основная функция: поиск из всех вершин src (количество не ограничено, вершины
+	 * обрабатываются пакетами по 64 * W).
+	 * ~~~~ Примечания:
+	 * Если hops == false, количество переходов не сохраняется (доступна только
+	 * достижимость); память результата - V * |src| бит вместо V * |src| чисел.
+	 * Возвращает false, если поиск прерван по control (nullptr - без ограничений).
+	*/
+	bool run(const vector<int> &src, bool hops = true, SearchControl *control = nullptr);
+
+	/*
+	 * Функция возвращает количество ребер в кратчайшем пути из i-й стартовой
+	 * вершины (в порядке вектора src) в вершину v либо -1, если v недостижима.
+	 * Доступна, если run() вызывалась с hops == true.
+	*/
+	inline int hops(int i, int v) const;
+
+	/* Функция проверки достижимости вершины v из i-й стартовой вершины. */
+	inline bool reachable(int i, int v) const;
+
+	/* Функция возвращает статистику последнего вызова run(). */
+	inline const Stats &statistics() const;
+};
+
+#endif // _MULTI_SOURCE_BFS_
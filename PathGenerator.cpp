@@ -0,0 +1,124 @@
+#include "PathGenerator.hpp"
+
+// Конструктор. Если w недостижима из v (по индексу) или номера вершин некорректны,
+// обход сразу считается завершенным. Устаревший индекс (версия графа изменилась
+// после его построения) отбрасывается: граф не изменяется, пока генератор
+// используется, поэтому версия проверяется один раз.
+template<typename Graph, typename Stats>
+PathGenerator<Graph, Stats>::PathGenerator(const Graph &graph, int v, int w,
+		const ReachabilityIndex<Graph> *index, SearchControl *control) :
+	G(graph), index(index && index->version() == graph.version() ? index : nullptr),
+	control(control), w(w), single(false), yielded(0)
+{
+	stats.begin(QueryStats::SETUP);
+	bool valid = v >= 0 && w >= 0 && v < G.V() && w < G.V() && (!this->index || this->index->reachable(v, w));
+	if(valid && v == w)
+		single = true;
+	else if(valid) {
+		on_path.assign(G.V(), 0);
+		on_path[v] = 1;
+		path.push_back(v);
+		cost.push_back(0);
+		frames.emplace_back(G, v);
+		stats.expand();
+		stats.allocate(on_path.size());
+	}
+	stats.end();
+}
+
+// Функция поиска следующего пути. Верхний кадр стека продолжает перебор смежных
+// вершин последней вершины пути: вершина пути и вершины, из которых w недостижима,
+// пропускаются; при достижении w путь возвращается (w в стек не помещается), иначе
+// вершина добавляется к пути и для нее создается кадр. Исчерпанный кадр снимается
+// вместе с последней вершиной пути. Остановка по control проверяется перед каждым
+// продвижением, поэтому состояние обхода остается согласованным.
+template<typename Graph, typename Stats>
+bool PathGenerator<Graph, Stats>::next(vector<int> &result, int &path_cost) {
+	if(single) {
+		if(control && !control->poll())
+			return false;
+		single = false;
+		result.assign(1, w);
+		path_cost = 0;
+		++yielded;
+		stats.path();
+		if(control)
+			control->found();
+		return true;
+	}
+
+	stats.begin(QueryStats::SEARCH);
+	while(!frames.empty()) {
+		if(control && !control->step())
+			break;
+		frame &f = frames.back();
+		int u = (f.started ? f.iter.next() : f.iter.begin());
+		f.started = true;
+		if(f.iter.end()) {
+			on_path[path.back()] = 0;
+			path.pop_back();
+			cost.pop_back();
+			frames.pop_back();
+			continue;
+		}
+		stats.scan();
+		if(on_path[u] || (index && !index->reachable(u, w)))
+			continue;
+
+		int c = cost.back() + f.iter.cost();
+		if(u == w) {
+			result = path;
+			result.push_back(w);
+			path_cost = c;
+			++yielded;
+			stats.path();
+			stats.end();
+			if(control)
+				control->found();
+			return true;
+		}
+		on_path[u] = 1;
+		path.push_back(u);
+		cost.push_back(c);
+		frames.emplace_back(G, u);
+		stats.expand();
+	}
+	stats.end();
+	return false;
+}
+
+// Функция поиска следующего пути в строковом формате.
+template<typename Graph, typename Stats>
+bool PathGenerator<Graph, Stats>::next(string &result) {
+	vector<int> p;
+	int c;
+	if(!next(p, c))
+		return false;
+	stats.begin(QueryStats::FORMATTING);
+	result = PathTracer::format_simple(p, c);
+	stats.allocate(result.size());
+	stats.end();
+	return true;
+}
+
+// Функция возвращает не более n следующих путей.
+template<typename Graph, typename Stats>
+vector<string> PathGenerator<Graph, Stats>::take(int n) {
+	vector<string> res;
+	string p;
+	while((int)res.size() < n && next(p))
+		res.push_back(p);
+	return res;
+}
+
+// Функция проверки завершения обхода.
+template<typename Graph, typename Stats>
+bool PathGenerator<Graph, Stats>::done() const { return !single && frames.empty(); }
+
+// Функция возвращает количество возвращенных путей.
+template<typename Graph, typename Stats>
+long long PathGenerator<Graph, Stats>::count() const { return yielded; }
+
+// Функция возвращает статистику генератора.
+template<typename Graph, typename Stats>
+const Stats &PathGenerator<Graph, Stats>::statistics() const { return stats; }
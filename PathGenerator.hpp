@@ -0,0 +1,97 @@
+#ifndef _PATH_GENERATOR_
+#define _PATH_GENERATOR_
+
+#include "main_header.hpp"
+#include "ReachabilityIndex.hpp"
+#include "PathTracer.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Генератор простых путей из вершины v в вершину w графа Graph: возвращает пути
+ * по одному по запросу (метод next()), в том же порядке, что и
+ * DeepSearcher::get_paths().
+ * ~~~~ Примечания:
+ * Поиск в глубину выполняется без рекурсии: состояние обхода (стек итераторов
+ * смежных вершин вершин текущего пути) хранится в объекте, поэтому между вызовами
+ * next() обход приостановлен и продолжается с того же места. Память - O(V) на
+ * признаки вершин текущего пути плюс O(d) на стек (d - глубина обхода) и не
+ * зависит от количества найденных путей; первый путь возвращается без перебора
+ * остальных. Граф не должен изменяться, пока генератор используется.
+ * Если задан control (см. SearchControl), каждое продвижение обхода засчитывается
+ * как шаг, каждый путь - как результат; после остановки next() возвращает false,
+ * а после control->reset() обход продолжается с места остановки.
+ * Stats - политика статистики (см. NoStats, CountingStats). Статистика
+ * накапливается с момента создания генератора: подготовка (конструктор), поиск
+ * (продвижение обхода в next()) и форматирование строк путей.
+*/
+template<typename Graph, typename Stats = NoStats>
+class PathGenerator {
+private:
+	/* Кадр обхода: итератор смежных вершин вершины пути и признак начала перебора. */
+	struct frame {
+		typename Graph::adjIterator iter;
+		bool started;
+		frame(const Graph &G, int v) : iter(G, v), started(false) { }
+	};
+
+	const Graph &G;
+	const ReachabilityIndex<Graph> *index;
+	SearchControl *control;
+	int w;
+	/* Вершины текущего пути и стоимости его начал: cost[k] - стоимость path[0..k]. */
+	vector<int> path, cost;
+	vector<frame> frames;
+	/* on_path[u] != 0, если вершина u лежит на текущем пути. */
+	vector<char> on_path;
+	/* Признак пути из одной вершины (v == w), еще не возвращенного next(). */
+	bool single;
+	long long yielded;
+	Stats stats;
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; v, w - начальная и конечная вершины путей; index - индекс
+	 * достижимости графа G (nullptr - без отсечения, см. DeepSearcher; индекс,
+	 * построенный для другой версии графа, не используется); control - управление
+	 * обходом (nullptr - без ограничений).
+	*/
+	PathGenerator(const Graph &G, int v, int w, const ReachabilityIndex<Graph> *index = nullptr,
+		SearchControl *control = nullptr);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция поиска следующего пути. Записывает вершины пути v, k1, ..., kn, w в
+	 * result, его стоимость - в path_cost и возвращает true; если пути
+	 * закончились или обход остановлен (см. control), возвращает false.
+	*/
+	bool next(vector<int> &result, int &path_cost);
+
+	/*
+	 * Функция поиска следующего пути в формате DeepSearcher::get_paths():
+	 * "-v-k1-k2-...-kn-w, costs". Если пути закончились, возвращает false.
+	*/
+	bool next(string &result);
+
+	/*
+	 * Функция возвращает не более n следующих путей в формате
+	 * DeepSearcher::get_paths() (например, очередную страницу результатов).
+	*/
+	vector<string> take(int n);
+
+	/*
+	 * Функция проверки завершения обхода. Значение false не гарантирует, что
+	 * следующий путь существует: это выясняется только вызовом next().
+	*/
+	inline bool done() const;
+
+	/* Функция возвращает количество путей, возвращенных генератором. */
+	inline long long count() const;
+
+	/* Функция возвращает статистику генератора. */
+	inline const Stats &statistics() const;
+};
+
+#endif // _PATH_GENERATOR_
@@ -0,0 +1,110 @@
+#include "PathTracer.hpp"
+
+// Функция восстановления пути по матрице промежуточных вершин. Выведенная часть
+// пути занимает буфер с начала (buf[0..n)), стек - с конца (buf[top..capacity)),
+// на вершине стека - ближайшая еще не выведенная вершина пути. Если путь из
+// текущей вершины cur в вершину t на вершине стека - одно ребро, t выводится,
+// иначе в стек добавляется разбивающая вершина k.
+int PathTracer::from_splits(const int *tracer, size_t stride, int v, int w, int *buf, int capacity) {
+	if(capacity < 1)
+		return -1;
+	int n = 0, top = capacity, cur = v;
+	buf[n++] = v;
+	if(v == w)
+		return n;
+	if(n >= top)
+		return -1;
+	buf[--top] = w;
+	while(top < capacity) {
+		int t = buf[top], k = tracer[cur * stride + t];
+		if(k == -1) {
+			++top;
+			buf[n++] = cur = t;
+		}
+		else {
+			if(n >= top)
+				return -1;
+			buf[--top] = k;
+		}
+	}
+	return n;
+}
+
+// Функция восстановления пути по матрице промежуточных вершин в вектор. Длина
+// пути заранее неизвестна, поэтому при нехватке места емкость вектора удваивается.
+void PathTracer::from_splits(const int *tracer, size_t stride, int v, int w, vector<int> &path) {
+	path.resize(max<size_t>(path.capacity(), 16));
+	int n;
+	while((n = from_splits(tracer, stride, v, w, path.data(), path.size())) == -1)
+		path.resize(path.size() * 2);
+	path.resize(n);
+}
+
+// Функция восстановления пути по предшественникам. Вершины записываются от w к v,
+// затем порядок обращается на месте.
+template<typename Pred>
+int PathTracer::from_predecessors(const Pred &pred, int v, int w, int *buf, int capacity) {
+	int n = 0;
+	for(int u = w; ; u = pred(u)) {
+		if(n >= capacity || u == -1)
+			return -1;
+		buf[n++] = u;
+		if(u == v)
+			break;
+	}
+	reverse(buf, buf + n);
+	return n;
+}
+
+// Функция восстановления пути по предшественникам в вектор. Если цепочка
+// предшественников обрывается, не дойдя до v, вектор очищается.
+template<typename Pred>
+void PathTracer::from_predecessors(const Pred &pred, int v, int w, vector<int> &path) {
+	path.clear();
+	for(int u = w; u != -1; u = pred(u)) {
+		path.push_back(u);
+		if(u == v)
+			break;
+	}
+	if(path.empty() || path.back() != v)
+		path.clear();
+	reverse(path.begin(), path.end());
+}
+
+// Функция возвращает строку вида "v-k1-k2-...-kn-w, P". Для пути из одной
+// вершины v она выводится дважды ("v-v, P").
+string PathTracer::format(const int *path, int len, int cost) {
+	string res;
+	res.reserve(len * 8 + 16);
+	for(int i = 0; i < len; ++i) {
+		if(i > 0)
+			res += '-';
+		res += to_string(path[i]);
+	}
+	if(len == 1)
+		res += "-" + to_string(path[0]);
+	res += ", ";
+	res += (cost == INF_COST ? "inf" : to_string(cost));
+	return res;
+}
+
+string PathTracer::format(const vector<int> &path, int cost) {
+	return format(path.data(), path.size(), cost);
+}
+
+// Функция возвращает строку вида "-v-k1-k2-...-kn-w, P" (формат DeepSearcher).
+string PathTracer::format_simple(const vector<int> &path, int cost) {
+	string res;
+	res.reserve(path.size() * 8 + 16);
+	for(int u : path)
+		res += "-" + to_string(u);
+	res += ", ";
+	res += (cost == INF_COST ? "inf" : to_string(cost));
+	return res;
+}
+
+// Функция возвращает строку "v-w, inf".
+string PathTracer::format(int v, int w) {
+	int path[2] = {v, w};
+	return format(path, 2, INF_COST);
+}
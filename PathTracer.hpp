@@ -0,0 +1,75 @@
+#ifndef _PATH_TRACER_
+#define _PATH_TRACER_
+
+#include "main_header.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Набор статических функций восстановления кратчайших путей по результатам
+ * классов поиска: по матрице промежуточных вершин алгоритма Флойда (см.
+ * ShortestPathSearcher) либо по предшественникам вершин в дереве кратчайших путей
+ * (DijkstraSearcher, AllPairsSearcher, DistanceStore и др.).
+ * ~~~~ Примечания:
+ * Путь записывается номерами вершин v, k1, ..., kn, w в буфер вызывающего кода
+ * либо в вектор. Восстановление итеративное, выполняется за время, пропорциональное
+ * длине пути, и не создает промежуточных строк; функции для буфера не выделяют
+ * память. Строка вида "v-k1-k2-...-kn-w, P" формируется отдельной функцией
+ * format() - только если она действительно нужна.
+ * Функции для буфера возвращают количество записанных вершин либо -1, если
+ * путь не помещается в буфер (содержимое буфера в этом случае не определено) или
+ * цепочка предшественников обрывается; функции для вектора в последнем случае
+ * оставляют вектор пустым.
+ * Наличие пути функции не проверяют: это делает вызывающий код по стоимости пути.
+*/
+class PathTracer {
+public:
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция восстановления пути из вершины v в вершину w по матрице tracer с длиной
+	 * строки stride: tracer[i * stride + j] - вершина k, разбивающая путь i-j на пути
+	 * i-k и k-j, либо -1, если путь i-j состоит из одного ребра.
+	 * ~~~~ Примечания:
+	 * Вместо рекурсии по k используется стек еще не выведенных вершин пути, который
+	 * размещается в конце того же буфера: вершины стека - это будущие вершины пути,
+	 * поэтому выведенная часть и стек вместе никогда не длиннее всего пути.
+	*/
+	static int from_splits(const int *tracer, size_t stride, int v, int w, int *buf, int capacity);
+
+	/* Функция восстановления пути по матрице tracer в вектор path (см. выше). */
+	static void from_splits(const int *tracer, size_t stride, int v, int w, vector<int> &path);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция восстановления пути из вершины v в вершину w по предшественникам:
+	 * pred(u) - вершина, предшествующая u на кратчайшем пути из v.
+	 * ~~~~ Примечания:
+	 * Pred - любой вызываемый объект int(int), например лямбда-выражение над
+	 * вектором предков дерева кратчайших путей.
+	*/
+	template<typename Pred>
+	static int from_predecessors(const Pred &pred, int v, int w, int *buf, int capacity);
+
+	/* Функция восстановления пути по предшественникам в вектор path (см. выше). */
+	template<typename Pred>
+	static void from_predecessors(const Pred &pred, int v, int w, vector<int> &path);
+
+	/*
+	 * Функция возвращает строку вида "v-k1-k2-...-kn-w, P", где v, k1, ..., kn, w -
+	 * len вершин пути path, а P - его стоимость cost. Начальная и конечная вершины
+	 * выводятся всегда, поэтому путь из одной вершины v записывается как "v-v, P"
+	 * (как в ShortestPathSearcher::get_path()).
+	*/
+	static string format(const int *path, int len, int cost);
+	static string format(const vector<int> &path, int cost);
+
+	/*
+	 * Функция возвращает строку в формате DeepSearcher::get_paths():
+	 * "-v-k1-k2-...-kn-w, P"; путь из одной вершины v записывается как "-v, P".
+	*/
+	static string format_simple(const vector<int> &path, int cost);
+
+	/* Функция возвращает строку "v-w, inf", обозначающую отсутствие пути из v в w. */
+	static string format(int v, int w);
+};
+
+#endif // _PATH_TRACER_
@@ -0,0 +1,243 @@
+#include "QueryServer.hpp"
+
+// Вспомогательная функция получения контекста поиска. Контекстов столько же,
+// сколько потоков пула, поэтому ожидание возможно только при вызове execute()
+// извне пула.
+QueryServer::context *QueryServer::acquire() {
+	unique_lock<mutex> lock(context_lock);
+	context_ready.wait(lock, [this] { return !idle.empty(); });
+	context *c = idle.back();
+	idle.pop_back();
+	return c;
+}
+
+// Вспомогательная функция возврата контекста поиска.
+void QueryServer::release(context *c) {
+	{
+		lock_guard<mutex> lock(context_lock);
+		idle.push_back(c);
+	}
+	context_ready.notify_one();
+}
+
+// Вспомогательная функция подсчета простых путей. В ациклическом графе любой путь
+// простой, поэтому количество путей в вершину - сумма количеств путей в ее
+// предшественников; вершины обрабатываются в топологическом порядке от v до w.
+// Суммы ограничиваются значением LLONG_MAX (количество путей растет экспоненциально).
+// В графе с циклами пути перебираются генератором без сохранения самих путей.
+long long QueryServer::count_paths(int v, int w, SearchControl *control) {
+	if(!dag.acyclic()) {
+		PathGenerator<CsrGraph> gen = deep.lazy_paths(v, w, control);
+		vector<int> path;
+		int cost;
+		while(gen.next(path, cost));
+		return gen.count();
+	}
+
+	const long long MAX = numeric_limits<long long>::max();
+	vector<long long> cnt(v_cnt, 0);
+	cnt[v] = 1;
+	const vector<int> &order = dag.order();
+	for(int k = dag.position(v); k <= dag.position(w); ++k) {
+		int u = order[k];
+		if(cnt[u] == 0)
+			continue;
+		for(int i = G.first(u); i < G.last(u); ++i) {
+			long long &x = cnt[G.target(i)];
+			x = (x > MAX - cnt[u] ? MAX : x + cnt[u]);
+		}
+	}
+	return cnt[w];
+}
+
+// Вспомогательная функция сохранения ответа. Ответы, следующие по порядку за
+// последним отправленным, записываются в дескриптор вывода под блокировкой
+// соединения, поэтому ответы разных запросов не перемежаются.
+void QueryServer::complete(connection &c, long long seq, string &&text) {
+	lock_guard<mutex> lock(c.m);
+	c.ready.emplace(seq, move(text));
+	for(auto it = c.ready.begin(); it != c.ready.end() && it->first == c.next; it = c.ready.begin()) {
+		write_all(c.out, it->second);
+		c.ready.erase(it);
+		++c.next;
+	}
+	if(--c.pending == 0)
+		c.drained.notify_all();
+}
+
+// Вспомогательная функция записи строки в дескриптор (с повтором при частичной записи).
+bool QueryServer::write_all(int fd, const string &text) {
+	for(size_t done = 0; done < text.size(); ) {
+		ssize_t n = ::write(fd, text.data() + done, text.size() - done);
+		if(n <= 0)
+			return false;
+		done += n;
+	}
+	return true;
+}
+
+// Конструктор. Индекс достижимости и топологический порядок строятся один раз.
+QueryServer::QueryServer(const CsrGraph &graph, int threads, size_t cache_bytes,
+		long long deadline_ms) :
+	G(graph), v_cnt(graph.V()), deadline_ms(deadline_ms), deep(G), reach(G), dag(G), pool(threads)
+{
+	if(cache_bytes > 0)
+		cache.reset(new ResultCache<string>(cache_bytes));
+	for(int t = 0; t < pool.size(); ++t) {
+		contexts.emplace_back(new context(G));
+		idle.push_back(contexts.back().get());
+	}
+}
+
+// Вспомогательная функция выполнения проверенного запроса. К количеству путей
+// прерванного запроса добавляется причина остановки.
+string QueryServer::answer(const string &cmd, int v, int w, int k, SearchControl *control) {
+	auto header = [control](long long n) {
+		string res = to_string(n);
+		if(control->stopped())
+			res += " " + SearchControl::name(control->result());
+		return res + "\n";
+	};
+	if(cmd == "COUNT")
+		return header(count_paths(v, w, control));
+
+	if(cmd == "PATHS" && k < 0) {
+		vector<string> paths = deep.get_paths(v, w, control);
+		string res = header(paths.size());
+		for(auto &p : paths)
+			res += p + "\n";
+		return res;
+	}
+
+	context *c = acquire();
+	string res;
+	if(cmd == "SHORTEST") {
+		res = c->shortest.get_path(v, w, control) + "\n";
+		if(control->stopped())
+			res = "ERR " + SearchControl::name(control->result()) + "\n";
+	} else {
+		vector<string> paths = c->kshortest.get_paths(v, w, k, control);
+		res = header(paths.size());
+		for(auto &p : paths)
+			res += p + "\n";
+	}
+	release(c);
+	return res;
+}
+
+// Функция выполнения одного запроса. Ключ кэша строится по разобранным параметрам,
+// поэтому запросы, различающиеся только пробелами, имеют общий ключ. Запросы REACH
+// выполняются быстрее обращения к кэшу и не кэшируются; прерванные запросы не
+// кэшируются, так как их ответы неполны. Срок выполнения отсчитывается от начала
+// выполнения запроса.
+string QueryServer::execute(const string &line) {
+	stringstream ss(line);
+	string cmd;
+	int v = -1, w = -1, k = -1;
+	ss >> cmd >> v >> w;
+	if(cmd != "PATHS" && cmd != "SHORTEST" && cmd != "REACH" && cmd != "COUNT")
+		return "ERR unknown command\n";
+	if(ss.fail() || v < 0 || w < 0 || v >= v_cnt || w >= v_cnt)
+		return "ERR bad vertex\n";
+
+	if(cmd == "REACH") {
+		if(reach.algorithm() == ReachabilityIndex<CsrGraph>::CLOSURE)
+			return reach.reachable(v, w) ? "1\n" : "0\n";
+		lock_guard<mutex> lock(reach_lock);
+		return reach.reachable(v, w) ? "1\n" : "0\n";
+	}
+	if(cmd == "PATHS")
+		k = (ss >> k ? max(k, 0) : -1);
+
+	string key = cmd + " " + to_string(v) + " " + to_string(w), res;
+	if(k >= 0)
+		key += " " + to_string(k);
+	if(cache && cache->get(key, G.version(), res))
+		return res;
+
+	SearchControl control;
+	if(deadline_ms > 0)
+		control.set_timeout(deadline_ms);
+	res = answer(cmd, v, w, k, &control);
+	if(cache && !control.stopped())
+		cache->put(key, G.version(), res);
+	return res;
+}
+
+// Функция обслуживания соединения. Запросы читаются блоками и разбиваются на
+// строки; каждый запрос получает номер и выполняется задачей пула, которая по
+// завершении передает ответ в complete(). Последняя строка ввода, не
+// завершенная переводом строки, также считается запросом. После окончания ввода
+// функция ожидает выполнения всех запросов соединения.
+void QueryServer::serve(int in, int out) {
+	auto c = make_shared<connection>(in, out);
+	long long seq = 0;
+	string buf;
+	char chunk[1 << 16];
+	bool quit = false;
+	ssize_t n;
+
+	// Обработка одной строки ввода; возвращает false для команды QUIT.
+	auto handle = [&](string line) {
+		if(!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if(line.empty())
+			return true;
+		if(line == "QUIT")
+			return false;
+		{
+			lock_guard<mutex> lock(c->m);
+			++c->pending;
+		}
+		pool.submit([this, c, line, s = seq++] {
+			complete(*c, s, execute(line));
+		});
+		return true;
+	};
+
+	while(!quit && (n = ::read(in, chunk, sizeof(chunk))) > 0) {
+		buf.append(chunk, n);
+		size_t start = 0, end;
+		while(!quit && (end = buf.find('\n', start)) != string::npos) {
+			quit = !handle(buf.substr(start, end - start));
+			start = end + 1;
+		}
+		buf.erase(0, start);
+	}
+	if(!quit && !buf.empty())
+		handle(buf);
+
+	unique_lock<mutex> lock(c->m);
+	c->drained.wait(lock, [&] { return c->pending == 0; });
+}
+
+// Функция приема соединений через Unix-сокет.
+bool QueryServer::listen(const string &path) {
+	sockaddr_un addr;
+	if(path.size() >= sizeof(addr.sun_path))
+		return false;
+	int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0)
+		return false;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path.c_str());
+	::unlink(path.c_str());
+	if(::bind(fd, (sockaddr *)&addr, sizeof(addr)) < 0 || ::listen(fd, 64) < 0) {
+		::close(fd);
+		return false;
+	}
+
+	while(true) {
+		int client = ::accept(fd, nullptr, nullptr);
+		if(client < 0)
+			continue;
+		thread([this, client] {
+			serve(client, client);
+			::close(client);
+		}).detach();
+	}
+}
+
+// Функция возвращает кэш ответов.
+const ResultCache<string> *QueryServer::answers() const { return cache.get(); }
@@ -0,0 +1,152 @@
+#ifndef _QUERY_SERVER_
+#define _QUERY_SERVER_
+
+#include "main_header.hpp"
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+#include "DeepSearcher.hpp"
+#include "DijkstraSearcher.hpp"
+#include "KShortestSearcher.hpp"
+#include "ReachabilityIndex.hpp"
+#include "DagSearcher.hpp"
+#include "ResultCache.hpp"
+
+#include <map>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Сервер запросов к графу, загруженному один раз: принимает запросы в текстовом
+ * построчном протоколе из потока (стандартный ввод/вывод) или через Unix-сокет и
+ * выполняет их в пуле потоков.
+ * ~~~~ Примечания:
+ * Протокол - одна строка на запрос, номера вершин - десятичные:
+ * 1) "PATHS v w" - все простые пути из v в w (см. DeepSearcher::get_paths());
+ *    "PATHS v w k" - не более k кратчайших простых путей (см. KShortestSearcher);
+ *    ответ - строка с количеством путей n, затем n строк "-v-k1-...-w, costs";
+ * 2) "SHORTEST v w" - кратчайший путь, ответ - строка "v-k1-...-w, P" или "v-w, inf";
+ * 3) "REACH v w" - "1", если w достижима из v, иначе "0" (см. ReachabilityIndex);
+ * 4) "COUNT v w" - количество простых путей из v в w (для ациклического графа
+ *    вычисляется за O(V + E) и ограничивается сверху значением LLONG_MAX, иначе -
+ *    перебором путей);
+ * 5) "QUIT" - завершение соединения.
+ * На ошибочный запрос возвращается строка "ERR <описание>".
+ * Если задан срок выполнения запроса (см. конструктор), поиск, не уложившийся в
+ * него, прерывается (см. SearchControl): PATHS и COUNT возвращают найденные к
+ * этому моменту пути (количество), и первая строка ответа имеет вид
+ * "n deadline exceeded"; SHORTEST возвращает "ERR deadline exceeded".
+ * Запросы одного соединения конвейеризуются: клиент может отправить несколько
+ * запросов, не дожидаясь ответов; запросы выполняются параллельно, а ответы
+ * отправляются строго в порядке запросов. Поиски Дейкстры и Йена используют
+ * изменяемые буферы, поэтому каждая задача берет из общего набора отдельный
+ * контекст (по одному на поток пула).
+ * Ответы на запросы PATHS, SHORTEST и COUNT могут сохраняться в кэше (см.
+ * ResultCache) с ключом - нормализованным запросом и версией графа; повторный
+ * запрос возвращается из кэша без поиска. Неполные ответы не кэшируются.
+*/
+class QueryServer {
+private:
+	/* Изменяемые объекты поиска, используемые одной задачей. */
+	struct context {
+		DijkstraSearcher<CsrGraph> shortest;
+		KShortestSearcher<CsrGraph> kshortest;
+		context(const CsrGraph &G) : shortest(G), kshortest(G) { }
+	};
+
+	/*
+	 * Соединение: дескрипторы ввода и вывода, готовые ответы, ожидающие отправки
+	 * (по номеру запроса), номер следующего отправляемого ответа и количество
+	 * невыполненных запросов.
+	*/
+	struct connection {
+		int in, out;
+		mutex m;
+		condition_variable drained;
+		map<long long, string> ready;
+		long long next;
+		int pending;
+		connection(int in, int out) : in(in), out(out), next(0), pending(0) { }
+	};
+
+	CsrGraph G;
+	int v_cnt;
+	/* Срок выполнения одного запроса в миллисекундах (0 - без ограничения). */
+	long long deadline_ms;
+	DeepSearcher<CsrGraph> deep;
+	ReachabilityIndex<CsrGraph> reach;
+	/* Запросы к индексу в режиме INTERVALS используют его буферы и выполняются под блокировкой. */
+	mutex reach_lock;
+	DagSearcher<CsrGraph> dag;
+
+	/* Кэш ответов (nullptr, если кэширование отключено). */
+	unique_ptr<ResultCache<string>> cache;
+
+	vector<unique_ptr<context>> contexts;
+	vector<context *> idle;
+	mutex context_lock;
+	condition_variable context_ready;
+	ThreadPool pool;
+
+	/* Вспомогательные функции получения и возврата контекста поиска. */
+	context *acquire();
+	void release(context *c);
+
+	/* Вспомогательная функция подсчета простых путей из v в w (control - см. answer()). */
+	long long count_paths(int v, int w, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция выполнения проверенного запроса cmd с вершинами v, w
+	 * и параметром k (-1, если не задан) под управлением control.
+	*/
+	string answer(const string &cmd, int v, int w, int k, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция сохранения ответа text на запрос с номером seq и
+	 * отправки всех ответов, готовых к отправке по порядку.
+	*/
+	static void complete(connection &c, long long seq, string &&text);
+
+	/* Вспомогательная функция записи всей строки text в дескриптор fd. */
+	static bool write_all(int fd, const string &text);
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф в CSR-представлении (копируется); threads - количество потоков
+	 * пула (0 - по количеству аппаратных потоков); cache_bytes - ограничение
+	 * памяти кэша ответов в байтах (0 - кэширование отключено); deadline_ms - срок
+	 * выполнения одного запроса в миллисекундах (0 - без ограничения).
+	*/
+	QueryServer(const CsrGraph &G, int threads = 0, size_t cache_bytes = 0,
+		long long deadline_ms = 0);
+
+	/*
+	 * Функция выполнения одного запроса line. Возвращает ответ (одну или несколько
+	 * строк, каждая заканчивается символом '\n'). Может вызываться из нескольких
+	 * потоков одновременно.
+	*/
+	string execute(const string &line);
+
+	/*
+	 * Функция обслуживания одного соединения: читает запросы из дескриптора in до
+	 * конца потока или команды QUIT (последний запрос может не заканчиваться
+	 * переводом строки) и записывает ответы в out. Возвращает управление после
+	 * отправки всех ответов.
+	*/
+	void serve(int in, int out);
+
+	/*
+	 * Функция приема соединений через Unix-сокет path; каждое соединение
+	 * обслуживается в отдельном потоке (см. serve()). Возвращает false, если сокет
+	 * не удалось создать; при успехе не возвращает управление.
+	*/
+	bool listen(const string &path);
+
+	/* Функция возвращает кэш ответов (nullptr, если кэширование отключено). */
+	inline const ResultCache<string> *answers() const;
+};
+
+#endif // _QUERY_SERVER_
@@ -0,0 +1,56 @@
+#include "RadixHeap.hpp"
+
+// Вспомогательная функция вычисления номера корзины: номер старшего бита, в
+// котором key отличается от last, плюс один (0, если key == last).
+int RadixHeap::bucket_of(unsigned key) const {
+	return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+}
+
+// Конструктор.
+RadixHeap::RadixHeap() : last(0), cnt(0) { }
+
+// Функция проверки кучи на пустоту.
+bool RadixHeap::empty() const { return cnt == 0; }
+
+// Функция возвращает количество записей в куче.
+int RadixHeap::size() const { return cnt; }
+
+// Функция добавления вершины v с приоритетом key.
+void RadixHeap::push(int v, unsigned key) {
+	buckets[bucket_of(key)].push_back({key, v});
+	++cnt;
+}
+
+// Функция извлечения вершины с минимальным приоритетом. Если корзина 0 пуста,
+// минимум первой непустой корзины становится новым значением last, и ее
+// элементы переносятся в корзины с меньшими номерами (каждый элемент отличается
+// от нового last в меньшем количестве старших битов).
+int RadixHeap::pop() {
+	if(buckets[0].empty()) {
+		int i = 1;
+		while(buckets[i].empty())
+			++i;
+		unsigned mn = buckets[i][0].key;
+		for(auto &x : buckets[i])
+			mn = min(mn, x.key);
+		last = mn;
+		for(auto &x : buckets[i])
+			buckets[bucket_of(x.key)].push_back(x);
+		buckets[i].clear();
+	}
+	int v = buckets[0].back().v;
+	buckets[0].pop_back();
+	--cnt;
+	return v;
+}
+
+// Функция возвращает приоритет последней извлеченной вершины.
+unsigned RadixHeap::last_key() const { return last; }
+
+// Функция очистки кучи.
+void RadixHeap::clear() {
+	for(auto &b : buckets)
+		b.clear();
+	last = 0;
+	cnt = 0;
+}
@@ -0,0 +1,61 @@
+#ifndef _RADIX_HEAP_
+#define _RADIX_HEAP_
+
+#include "main_header.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Радиксная куча - монотонная очередь с приоритетами для поиска кратчайших путей
+ * с целыми неотрицательными стоимостями.
+ * ~~~~ Примечания:
+ * Монотонность означает, что приоритет добавляемого элемента не меньше приоритета
+ * последнего извлеченного (last); в поиске Дейкстры это условие выполняется
+ * всегда. Элемент с приоритетом key хранится в корзине с номером, равным номеру
+ * старшего бита, в котором key отличается от last (0 - если key == last). При
+ * извлечении из пустой корзины 0 первая непустая корзина перераспределяется по
+ * младшим корзинам относительно ее минимума; каждый элемент перемещается не более
+ * 32 раз, поэтому операции выполняются за амортизированное O(log C).
+ * Уменьшение приоритета не поддерживается: вершина добавляется повторно, а
+ * устаревшие записи отбрасывает вызывающий код (сравнением с текущим расстоянием).
+*/
+class RadixHeap {
+private:
+	/* Элемент кучи: приоритет key вершины v. */
+	struct item {
+		unsigned key;
+		int v;
+	};
+
+	vector<item> buckets[33];
+	unsigned last;
+	int cnt;
+
+	/* Вспомогательная функция вычисления номера корзины для приоритета key. */
+	inline int bucket_of(unsigned key) const;
+public:
+	/* Конструктор. Создает пустую кучу. */
+	RadixHeap();
+
+	/* Функция проверки кучи на пустоту. */
+	inline bool empty() const;
+
+	/* Функция возвращает количество записей в куче (включая устаревшие). */
+	inline int size() const;
+
+	/* Функция добавления вершины v с приоритетом key (key не меньше last_key()). */
+	inline void push(int v, unsigned key);
+
+	/*
+	 * Функция извлечения вершины с минимальным приоритетом. Возвращает номер
+	 * вершины; ее приоритет возвращает функция last_key().
+	*/
+	inline int pop();
+
+	/* Функция возвращает приоритет последней извлеченной вершины. */
+	inline unsigned last_key() const;
+
+	/* Функция очистки кучи. Выделенная под корзины память сохраняется. */
+	void clear();
+};
+
+#endif // _RADIX_HEAP_
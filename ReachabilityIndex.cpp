@@ -0,0 +1,204 @@
+#include "ReachabilityIndex.hpp"
+
+// Вспомогательная функция построения транзитивного замыкания. Компоненты
+// обрабатываются в порядке возрастания номеров: к моменту обработки компоненты c
+// строки всех ее преемников уже построены, и строка c - объединение их строк и бита c.
+// Построение строки засчитывается как шаг control.
+template<typename Graph, typename Stats>
+bool ReachabilityIndex<Graph, Stats>::build_closure(SearchControl *control) {
+	const CsrGraph &dag = scc.condensation();
+	words = (c_cnt + 63) / 64;
+	closure.assign(words * c_cnt, 0);
+	stats.allocate(closure.size() * sizeof(uint64_t));
+	for(int c = 0; c < c_cnt; ++c) {
+		if(control && !control->step())
+			return false;
+		stats.expand();
+		uint64_t *row = &closure[c * words];
+		row[c / 64] |= 1ULL << (c % 64);
+		for(int k = dag.first(c); k < dag.last(c); ++k) {
+			stats.scan();
+			const uint64_t *succ = &closure[dag.target(k) * words];
+			for(size_t i = 0; i < words; ++i)
+				row[i] |= succ[i];
+		}
+	}
+	return true;
+}
+
+// Вспомогательная функция построения интервальных меток. Для каждого из LABELS
+// обходов корни и преемники просматриваются в случайном порядке (с фиксированным
+// зерном, чтобы индекс строился детерминированно); post - номер компоненты в
+// порядке завершения обхода. lo вычисляется в порядке возрастания номеров компонент
+// (преемники раньше предшественников) как минимум post по всем достижимым компонентам.
+// Перед каждым обходом control проверяется сразу.
+template<typename Graph, typename Stats>
+bool ReachabilityIndex<Graph, Stats>::build_intervals(SearchControl *control) {
+	const CsrGraph &dag = scc.condensation();
+	lo.assign((size_t)c_cnt * LABELS, 0);
+	post.assign((size_t)c_cnt * LABELS, 0);
+	stats.allocate(2LL * c_cnt * LABELS * sizeof(int));
+	vector<int> roots(c_cnt), mark(c_cnt);
+	vector<pair<int, int>> frames;
+	mt19937 rnd(c_cnt);
+	for(int c = 0; c < c_cnt; ++c)
+		roots[c] = c;
+
+	for(int l = 0; l < LABELS; ++l) {
+		if(control && !control->poll())
+			return false;
+		shuffle(roots.begin(), roots.end(), rnd);
+		fill(mark.begin(), mark.end(), 0);
+		int rank = 0;
+		for(int r : roots) {
+			if(mark[r])
+				continue;
+			mark[r] = 1;
+			frames.push_back({r, 0});
+			while(!frames.empty()) {
+				int c = frames.back().first, deg = dag.last(c) - dag.first(c);
+				int &k = frames.back().second;
+				if(k < deg) {
+					stats.scan();
+					// Преемники просматриваются с циклическим сдвигом, зависящим от обхода.
+					int d = dag.target(dag.first(c) + (k++ + l * (c + 1)) % deg);
+					if(!mark[d]) {
+						mark[d] = 1;
+						frames.push_back({d, 0});
+					}
+					continue;
+				}
+				stats.expand();
+				post[(size_t)c * LABELS + l] = rank++;
+				frames.pop_back();
+			}
+		}
+	}
+
+	for(int c = 0; c < c_cnt; ++c)
+		for(int l = 0; l < LABELS; ++l) {
+			int m = post[(size_t)c * LABELS + l];
+			for(int k = dag.first(c); k < dag.last(c); ++k)
+				m = min(m, lo[(size_t)dag.target(k) * LABELS + l]);
+			lo[(size_t)c * LABELS + l] = m;
+		}
+	visited.assign(c_cnt, 0);
+	stamp = 0;
+	return true;
+}
+
+// Вспомогательная функция проверки вложенности интервалов компоненты b в интервалы a.
+template<typename Graph, typename Stats>
+bool ReachabilityIndex<Graph, Stats>::contains(int a, int b) const {
+	const int *la = &lo[(size_t)a * LABELS], *pa = &post[(size_t)a * LABELS];
+	const int *lb = &lo[(size_t)b * LABELS], *pb = &post[(size_t)b * LABELS];
+	for(int l = 0; l < LABELS; ++l)
+		if(lb[l] < la[l] || pb[l] > pa[l])
+			return false;
+	return true;
+}
+
+// Конструктор. Если разбиение на компоненты прервано по control, представление
+// индекса не строится. Статистика учитывает только построение представления.
+template<typename Graph, typename Stats>
+ReachabilityIndex<Graph, Stats>::ReachabilityIndex(const Graph &G, method m, int threads,
+		SearchControl *control) :
+	scc(G, threads, control), c_cnt(scc.components()), built(false), built_version(G.version()),
+	words(0), stamp(0)
+{
+	used = (m == AUTO ? (c_cnt <= CLOSURE_LIMIT ? CLOSURE : INTERVALS) : m);
+	stats.reset();
+	if(control && control->stopped())
+		return;
+	stats.begin(QueryStats::SETUP);
+	built = (used == CLOSURE ? build_closure(control) : build_intervals(control));
+	stats.end();
+}
+
+// Функция проверки полноты индекса.
+template<typename Graph, typename Stats>
+bool ReachabilityIndex<Graph, Stats>::complete() const { return built; }
+
+// Функция возвращает используемое представление индекса.
+template<typename Graph, typename Stats>
+typename ReachabilityIndex<Graph, Stats>::method ReachabilityIndex<Graph, Stats>::algorithm() const {
+	return used;
+}
+
+// Функция возвращает номер версии графа, для которой построен индекс.
+template<typename Graph, typename Stats>
+unsigned long long ReachabilityIndex<Graph, Stats>::version() const { return built_version; }
+
+// Функция возвращает количество компонент сильной связности графа.
+template<typename Graph, typename Stats>
+int ReachabilityIndex<Graph, Stats>::components() const { return c_cnt; }
+
+// Функция возвращает номер компоненты сильной связности вершины v.
+template<typename Graph, typename Stats>
+int ReachabilityIndex<Graph, Stats>::component(int v) const { return scc.component(v); }
+
+// Функция проверки существования пути из v в w. Ребра конденсации ведут только к
+// меньшим номерам, поэтому если номер компоненты w больше номера компоненты v, путь
+// отсутствует. В режиме INTERVALS после проверки меток выполняется обход
+// конденсации в глубину из компоненты v, в который не попадают компоненты с
+// номером меньше номера компоненты w и компоненты, интервалы которых не содержат
+// ее интервалов. Обход выполняет вспомогательная функция search().
+template<typename Graph, typename Stats>
+bool ReachabilityIndex<Graph, Stats>::reachable(int v, int w) const {
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	bool res = search(v, w);
+	stats.end();
+	return res;
+}
+
+// Вспомогательная функция проверки существования пути из v в w без сброса статистики.
+template<typename Graph, typename Stats>
+bool ReachabilityIndex<Graph, Stats>::search(int v, int w) const {
+	if(!built)
+		return v == w;
+	int a = scc.component(v), b = scc.component(w);
+	if(a == b)
+		return true;
+	if(a < b)
+		return false;
+	if(used == CLOSURE)
+		return (closure[a * words + b / 64] >> (b % 64)) & 1;
+	if(!contains(a, b))
+		return false;
+
+	const CsrGraph &dag = scc.condensation();
+	if(++stamp == 0) {
+		fill(visited.begin(), visited.end(), 0);
+		stamp = 1;
+	}
+	stack.clear();
+	stack.push_back(a);
+	visited[a] = stamp;
+	while(!stack.empty()) {
+		int c = stack.back();
+		stack.pop_back();
+		stats.expand();
+		for(int k = dag.first(c); k < dag.last(c); ++k) {
+			stats.scan();
+			int d = dag.target(k);
+			if(d == b)
+				return true;
+			if(d < b || visited[d] == stamp || !contains(d, b))
+				continue;
+			visited[d] = stamp;
+			stack.push_back(d);
+		}
+	}
+	return false;
+}
+
+// Функция возвращает разбиение графа на компоненты сильной связности.
+template<typename Graph, typename Stats>
+const SccDecomposition<Graph, Stats> &ReachabilityIndex<Graph, Stats>::decomposition() const {
+	return scc;
+}
+
+// Функция возвращает статистику построения либо последнего вызова reachable().
+template<typename Graph, typename Stats>
+const Stats &ReachabilityIndex<Graph, Stats>::statistics() const { return stats; }
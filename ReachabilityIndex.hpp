@@ -0,0 +1,128 @@
+#ifndef _REACHABILITY_INDEX_
+#define _REACHABILITY_INDEX_
+
+#include "main_header.hpp"
+#include "SccDecomposition.hpp"
+#include "SearchStats.hpp"
+
+#include <cstdint>
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Индекс достижимости для графа Graph: отвечает на запрос "существует ли хотя бы
+ * один путь из вершины v в вершину w" без обхода графа.
+ * ~~~~ Примечания:
+ * Граф сжимается в ациклический граф компонент сильной связности (конденсацию):
+ * вершины одной компоненты достижимы друг из друга, а достижимость между
+ * компонентами определяется конденсацией. Далее строится одно из двух представлений:
+ * 1) CLOSURE - транзитивное замыкание конденсации в виде битовых строк (C^2 / 8
+ * байт для C компонент); запрос - одна проверка бита;
+ * 2) INTERVALS - интервальные метки (GRAIL): для нескольких случайных обходов в
+ * глубину каждой компоненте сопоставляется интервал [lo, post], где post - номер
+ * компоненты в обратном порядке обхода, lo - минимум по достижимым из нее
+ * компонентам. Если w достижима из v, интервал w вложен в интервал v во всех
+ * обходах, поэтому невложенность сразу дает ответ "нет"; в остальных случаях
+ * выполняется обход конденсации, отсекаемый теми же метками. Память - O(C).
+ * В режиме AUTO замыкание строится, если компонент не больше CLOSURE_LIMIT.
+ * Построение можно прервать (см. SearchControl): помимо проверок разбиения на
+ * компоненты, условия остановки проверяются для каждой строки замыкания и перед
+ * каждым обходом разметки. Неполный индекс не используется: reachable() для него
+ * возвращает true только для v = w.
+ * Индекс описывает граф на момент построения и хранит номер его версии (см.
+ * version()): DeepSearcher и PathGenerator не используют для отсечения индекс,
+ * построенный для другой версии графа. Запросы в режиме INTERVALS
+ * используют внутренние буферы, поэтому экземпляр не предназначен для
+ * одновременного использования из нескольких потоков.
+ * Stats - политика статистики (см. NoStats, CountingStats): построение
+ * представления (этап подготовки) учитывает обработанные компоненты, просмотренные
+ * дуги конденсации и объем индекса; каждый вызов reachable() сбрасывает
+ * статистику и учитывает компоненты и дуги обхода конденсации (этап поиска).
+ * Статистику разбиения на компоненты возвращает decomposition().statistics().
+*/
+template<typename Graph, typename Stats = NoStats>
+class ReachabilityIndex {
+public:
+	/* Представление индекса: AUTO - выбор по количеству компонент. */
+	enum method { AUTO, CLOSURE, INTERVALS };
+private:
+	/* Максимальное количество компонент, при котором в режиме AUTO строится замыкание. */
+	static const int CLOSURE_LIMIT = 16384;
+	/* Количество обходов (интервальных меток на компоненту) в режиме INTERVALS. */
+	static const int LABELS = 3;
+
+	/* Компоненты (номера образуют обратный топологический порядок) и конденсация. */
+	SccDecomposition<Graph, Stats> scc;
+	int c_cnt;
+	method used;
+	/* Признак полностью построенного индекса. */
+	bool built;
+	/* Номер версии графа на момент построения. */
+	unsigned long long built_version;
+
+	/* Замыкание: строка компоненты c - words 64-битных слов, начиная с c * words. */
+	size_t words;
+	vector<uint64_t> closure;
+
+	/* Интервальные метки: lo[c * LABELS + i], post[c * LABELS + i]. */
+	vector<int> lo, post;
+	/* Буферы обхода конденсации при запросах. */
+	mutable vector<int> visited, stack;
+	mutable int stamp;
+	/* Статистика построения либо последнего запроса. */
+	mutable Stats stats;
+
+	/*
+	 * Вспомогательные функции построения транзитивного замыкания конденсации и
+	 * интервальных меток. Возвращают false, если построение прервано по control.
+	*/
+	bool build_closure(SearchControl *control);
+	bool build_intervals(SearchControl *control);
+
+	/* Вспомогательная функция проверки вложенности интервалов компоненты b в интервалы a. */
+	inline bool contains(int a, int b) const;
+
+	/* Вспомогательная функция проверки пути (см. reachable()) без сброса статистики. */
+	bool search(int v, int w) const;
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; m - представление индекса (AUTO - по количеству компонент); threads -
+	 * количество потоков разбиения на компоненты (см. SccDecomposition); control -
+	 * управление построением (nullptr - без ограничений).
+	*/
+	ReachabilityIndex(const Graph &G, method m = AUTO, int threads = 1,
+		SearchControl *control = nullptr);
+
+	/* Функция возвращает используемое представление индекса (CLOSURE или INTERVALS). */
+	inline method algorithm() const;
+
+	/* Функция проверки полноты индекса (false, если построение прервано по control). */
+	inline bool complete() const;
+
+	/*
+	 * Функция возвращает номер версии графа, для которой построен индекс (см.
+	 * DenseGraph::version()). Если граф с тех пор изменялся, индекс устарел.
+	*/
+	inline unsigned long long version() const;
+
+	/* Функция возвращает количество компонент сильной связности графа. */
+	inline int components() const;
+
+	/* Функция возвращает номер компоненты сильной связности вершины v. */
+	inline int component(int v) const;
+
+	/*
+	 * Функция проверки существования пути из вершины v в вершину w (каждая вершина
+	 * достижима из самой себя).
+	*/
+	bool reachable(int v, int w) const;
+
+	/* Функция возвращает разбиение графа на компоненты сильной связности. */
+	inline const SccDecomposition<Graph, Stats> &decomposition() const;
+
+	/* Функция возвращает статистику построения либо последнего вызова reachable(). */
+	inline const Stats &statistics() const;
+};
+
+#endif // _REACHABILITY_INDEX_
@@ -0,0 +1,140 @@
+#include "ResultCache.hpp"
+
+// Вспомогательная функция выбора сегмента. Хэш перемешивается умножением, чтобы
+// номер сегмента не совпадал с младшими битами, по которым выбирается корзина
+// хэш-таблицы сегмента.
+template<typename Value>
+typename ResultCache<Value>::shard &ResultCache<Value>::shard_of(const string &key) {
+	unsigned long long h = hash<string>()(key) * 0x9E3779B97F4A7C15ull;
+	return *shards[(h >> 32) % shards.size()];
+}
+
+// Вспомогательная функция удаления записи сегмента.
+template<typename Value>
+void ResultCache<Value>::erase(shard &s, typename list<entry>::iterator it) {
+	s.used -= it->size;
+	s.index.erase(it->key);
+	s.lru.erase(it);
+}
+
+// Вспомогательные функции оценки памяти, занимаемой значением вне объекта: для
+// строк учитывается длина, для векторов строк - суммарный размер строк; сам
+// объект учтен в NODE_BYTES.
+template<typename Value>
+size_t ResultCache<Value>::bytes(const string &value) { return value.size(); }
+
+template<typename Value>
+size_t ResultCache<Value>::bytes(const vector<string> &value) {
+	size_t total = 0;
+	for(auto &s : value)
+		total += sizeof(string) + s.size();
+	return total;
+}
+
+template<typename Value>
+template<typename T>
+size_t ResultCache<Value>::bytes(const T &) { return 0; }
+
+// Конструктор. Ограничение памяти делится между сегментами поровну.
+template<typename Value>
+ResultCache<Value>::ResultCache(size_t capacity, int segments) : hit_cnt(0), miss_cnt(0) {
+	segments = max(segments, 1);
+	for(int i = 0; i < segments; ++i)
+		shards.emplace_back(new shard());
+	shard_capacity = capacity / segments;
+}
+
+// Функция поиска результата. Найденная запись переносится в начало списка LRU.
+// Устаревшая запись (более старой версии) удаляется; запись более новой версии
+// сохраняется - ее может запрашивать читатель более нового снимка графа.
+template<typename Value>
+bool ResultCache<Value>::get(const string &key, unsigned long long version, Value &value) {
+	shard &s = shard_of(key);
+	lock_guard<mutex> lock(s.m);
+	auto it = s.index.find(key);
+	if(it == s.index.end() || it->second->version != version) {
+		if(it != s.index.end() && it->second->version < version)
+			erase(s, it->second);
+		++miss_cnt;
+		return false;
+	}
+	s.lru.splice(s.lru.begin(), s.lru, it->second);
+	value = it->second->value;
+	++hit_cnt;
+	return true;
+}
+
+// Функция сохранения результата. Новая запись помещается в начало списка LRU,
+// затем с конца списка удаляются записи, пока сегмент не уложится в ограничение.
+template<typename Value>
+void ResultCache<Value>::put(const string &key, unsigned long long version, const Value &value) {
+	size_t size = NODE_BYTES + 2 * key.size() + bytes(value);
+	if(size > shard_capacity)
+		return;
+	shard &s = shard_of(key);
+	lock_guard<mutex> lock(s.m);
+	auto it = s.index.find(key);
+	if(it != s.index.end()) {
+		if(it->second->version > version)
+			return;
+		erase(s, it->second);
+	}
+	s.lru.push_front({key, version, value, size});
+	s.index.emplace(key, s.lru.begin());
+	s.used += size;
+	while(s.used > shard_capacity)
+		erase(s, prev(s.lru.end()));
+}
+
+// Функция возвращает результат запроса из кэша либо вычисляет и сохраняет его.
+template<typename Value>
+Value ResultCache<Value>::get_or_compute(const string &key, unsigned long long version,
+		const function<Value()> &compute)
+{
+	Value value;
+	if(get(key, version, value))
+		return value;
+	value = compute();
+	put(key, version, value);
+	return value;
+}
+
+// Функция удаления всех записей.
+template<typename Value>
+void ResultCache<Value>::clear() {
+	for(auto &s : shards) {
+		lock_guard<mutex> lock(s->m);
+		s->lru.clear();
+		s->index.clear();
+		s->used = 0;
+	}
+}
+
+// Функции возвращают количество попаданий и промахов.
+template<typename Value>
+long long ResultCache<Value>::hits() const { return hit_cnt; }
+
+template<typename Value>
+long long ResultCache<Value>::misses() const { return miss_cnt; }
+
+// Функция возвращает количество записей.
+template<typename Value>
+size_t ResultCache<Value>::entries() {
+	size_t total = 0;
+	for(auto &s : shards) {
+		lock_guard<mutex> lock(s->m);
+		total += s->lru.size();
+	}
+	return total;
+}
+
+// Функция возвращает оценку памяти, занимаемой записями.
+template<typename Value>
+size_t ResultCache<Value>::size() {
+	size_t total = 0;
+	for(auto &s : shards) {
+		lock_guard<mutex> lock(s->m);
+		total += s->used;
+	}
+	return total;
+}
@@ -0,0 +1,119 @@
+#ifndef _RESULT_CACHE_
+#define _RESULT_CACHE_
+
+#include "main_header.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Потокобезопасный кэш результатов запросов к графу с вытеснением давно не
+ * использованных записей (LRU) и ограничением занимаемой памяти.
+ * ~~~~ Примечания:
+ * Ключ записи - строка с параметрами запроса (например, "PATHS 0 4"), значение -
+ * результат запроса типа Value (string, vector<string>, число и т.п.). Каждая
+ * запись хранит номер версии графа, для которой вычислен результат (см.
+ * DenseGraph::version()); запись другой версии считается отсутствующей, а
+ * запись более старой версии при обращении удаляется. Поэтому после изменения
+ * графа устаревшие результаты никогда не возвращаются, а сброс кэша не
+ * требуется: старые записи вытесняются по мере заполнения. Один кэш должен
+ * использоваться для запросов к одному графу.
+ * Записи распределены по сегментам по хэшу ключа; у каждого сегмента свои
+ * блокировка, список LRU и доля ограничения памяти, поэтому обращения к разным
+ * сегментам из разных потоков не блокируют друг друга. Размер записи оценивается
+ * по длине ключа и значения с учетом служебных данных (см. bytes()).
+*/
+template<typename Value>
+class ResultCache {
+private:
+	/* Запись кэша: ключ, версия графа, значение и оценка занимаемой памяти. */
+	struct entry {
+		string key;
+		unsigned long long version;
+		Value value;
+		size_t size;
+	};
+
+	/*
+	 * Сегмент кэша: записи в порядке от последней использованной к давно не
+	 * использованной, индекс записей по ключу и суммарный размер записей.
+	*/
+	struct shard {
+		mutex m;
+		list<entry> lru;
+		unordered_map<string, typename list<entry>::iterator> index;
+		size_t used;
+		shard() : used(0) { }
+	};
+
+	/* Оценка служебных данных записи: узлы списка и хэш-таблицы. */
+	static const size_t NODE_BYTES = sizeof(entry) + 8 * sizeof(void *);
+
+	vector<unique_ptr<shard>> shards;
+	/* Ограничение памяти одного сегмента в байтах. */
+	size_t shard_capacity;
+	atomic<long long> hit_cnt, miss_cnt;
+
+	/* Вспомогательная функция выбора сегмента по ключу key. */
+	shard &shard_of(const string &key);
+
+	/* Вспомогательная функция удаления записи it сегмента s (под блокировкой s). */
+	static void erase(shard &s, typename list<entry>::iterator it);
+
+	/* Вспомогательные функции оценки памяти, занимаемой значением. */
+	static size_t bytes(const string &value);
+	static size_t bytes(const vector<string> &value);
+	template<typename T>
+	static size_t bytes(const T &value);
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * capacity - ограничение памяти, занимаемой записями, в байтах; segments -
+	 * количество сегментов (не меньше 1).
+	*/
+	ResultCache(size_t capacity, int segments = 16);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция поиска результата запроса key для версии графа version. Если
+	 * результат найден, он записывается в value и функция возвращает true.
+	 * ~~~~ Примечания:
+	 * Для записи другой версии функция возвращает false; запись более старой
+	 * версии удаляется, более новой - сохраняется (ее не вытесняет читатель,
+	 * работающий со старым снимком графа, см. SnapshotGraph).
+	*/
+	bool get(const string &key, unsigned long long version, Value &value);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция сохранения результата value запроса key для версии графа version.
+	 * ~~~~ Примечания:
+	 * Запись более новой версии не заменяется (результат, вычисленный до изменения
+	 * графа, мог завершиться позже). Запись, размер которой превышает ограничение
+	 * сегмента, не сохраняется.
+	*/
+	void put(const string &key, unsigned long long version, const Value &value);
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция возвращает результат запроса key для версии графа version; если
+	 * результата нет в кэше, он вычисляется функцией compute и сохраняется.
+	 * ~~~~ Примечания:
+	 * compute вызывается без блокировки, поэтому одновременные промахи по одному
+	 * ключу из нескольких потоков вычисляют результат независимо.
+	*/
+	Value get_or_compute(const string &key, unsigned long long version,
+		const function<Value()> &compute);
+
+	/* Функция удаления всех записей. */
+	void clear();
+
+	/* Функции возвращают количество попаданий и промахов с момента создания. */
+	inline long long hits() const;
+	inline long long misses() const;
+
+	/* Функции возвращают количество записей и оценку занимаемой ими памяти в байтах. */
+	size_t entries();
+	size_t size();
+};
+
+#endif // _RESULT_CACHE_
@@ -0,0 +1,340 @@
+#include "SccDecomposition.hpp"
+
+// Вспомогательная функция алгоритма Тарьяна. Вместо рекурсии используется явный
+// стек кадров (вершина, индекс следующего ребра). Вершина, которой уже назначена
+// компонента, либо обработана ранее (в том числе до вызова функции), либо
+// завершена в текущем обходе и не лежит в стеке - в обоих случаях она не влияет
+// на low, поэтому признак "в стеке" не хранится отдельно. Компонента получает
+// номер в момент завершения, поэтому номера образуют обратный топологический порядок.
+// Посещение новой вершины засчитывается как шаг control.
+template<typename Graph, typename Stats>
+bool SccDecomposition<Graph, Stats>::tarjan(const CsrGraph &G, SearchControl *control) {
+	vector<int> index(v_cnt, -1), low(v_cnt), scc;
+	vector<pair<int, int>> frames;
+	int counter = 0;
+
+	for(int s = 0; s < v_cnt; ++s) {
+		if(comp[s] != -1 || index[s] != -1)
+			continue;
+		if(control && !control->step())
+			return false;
+		stats.expand();
+		index[s] = low[s] = counter++;
+		scc.push_back(s);
+		frames.push_back({s, G.first(s)});
+		while(!frames.empty()) {
+			int v = frames.back().first;
+			int &e = frames.back().second;
+			if(e < G.last(v)) {
+				int u = G.target(e++);
+				stats.scan();
+				if(comp[u] != -1)
+					continue;
+				if(index[u] == -1) {
+					if(control && !control->step())
+						return false;
+					stats.expand();
+					index[u] = low[u] = counter++;
+					scc.push_back(u);
+					frames.push_back({u, G.first(u)});
+				} else
+					low[v] = min(low[v], index[u]);
+				continue;
+			}
+			frames.pop_back();
+			if(low[v] == index[v]) {
+				int u;
+				do {
+					u = scc.back();
+					scc.pop_back();
+					comp[u] = c_cnt;
+				} while(u != v);
+				++c_cnt;
+			}
+			if(!frames.empty()) {
+				int p = frames.back().first;
+				low[p] = min(low[p], low[v]);
+			}
+		}
+	}
+	return true;
+}
+
+// Вспомогательная функция параллельного отсечения. Для каждой вершины без компоненты
+// подсчитываются входящие и исходящие дуги от (к) других таких вершин; вершины с
+// нулевой степенью помещаются в стек потока. Затем каждый поток удаляет вершины
+// своего стека, уменьшая степени соседей; сосед, у которого степень стала нулевой,
+// помещается в стек того же потока. Признак gone захватывается атомарно, поэтому
+// каждая вершина удаляется один раз; степени уже удаленных вершин (и вершин с
+// компонентой) не уменьшаются, их счетчики инициализируются нулем. Обработка стеков без синхронизации по уровням
+// важна для длинных цепочек, где уровней столько же, сколько вершин. Раунд
+// отсечения не прерывается: control проверяется перед его началом. Просмотренные
+// дуги подсчитываются каждым потоком отдельно, удаленные вершины учитываются как
+// раскрытые.
+template<typename Graph, typename Stats>
+bool SccDecomposition<Graph, Stats>::trim(const CsrGraph &fwd, const CsrGraph &bwd, ThreadPool &pool,
+		SearchControl *control)
+{
+	if(control && !control->poll())
+		return false;
+	int T = pool.size();
+	unique_ptr<atomic<int>[]> in(new atomic<int>[v_cnt]), out(new atomic<int>[v_cnt]);
+	unique_ptr<atomic<char>[]> gone(new atomic<char>[v_cnt]);
+	vector<vector<int>> work(T), removed(T);
+	vector<long long> scanned(T, 0);
+
+	auto active_degree = [&](const CsrGraph &G, int v, int t) {
+		scanned[t] += G.last(v) - G.first(v);
+		int d = 0;
+		for(int i = G.first(v); i < G.last(v); ++i)
+			d += (G.target(i) != v && comp[G.target(i)] == -1);
+		return d;
+	};
+	pool.run([&](int t) {
+		for(int v = (long long)v_cnt * t / T; v < (long long)v_cnt * (t + 1) / T; ++v) {
+			gone[v] = (comp[v] != -1);
+			in[v] = out[v] = 0;
+			if(gone[v])
+				continue;
+			in[v] = active_degree(bwd, v, t);
+			out[v] = active_degree(fwd, v, t);
+			if(in[v] == 0 || out[v] == 0) {
+				gone[v] = 1;
+				work[t].push_back(v);
+			}
+		}
+	});
+
+	pool.run([&](int t) {
+		auto &stack = work[t];
+		while(!stack.empty()) {
+			int v = stack.back();
+			stack.pop_back();
+			removed[t].push_back(v);
+			scanned[t] += (fwd.last(v) - fwd.first(v)) + (bwd.last(v) - bwd.first(v));
+			for(int i = fwd.first(v); i < fwd.last(v); ++i) {
+				int u = fwd.target(i);
+				if(u != v && !gone[u] && --in[u] == 0 && !gone[u].exchange(1))
+					stack.push_back(u);
+			}
+			for(int i = bwd.first(v); i < bwd.last(v); ++i) {
+				int u = bwd.target(i);
+				if(u != v && !gone[u] && --out[u] == 0 && !gone[u].exchange(1))
+					stack.push_back(u);
+			}
+		}
+	});
+
+	for(int t = 0; t < T; ++t) {
+		stats.expand(removed[t].size());
+		stats.scan(scanned[t]);
+		for(int v : removed[t])
+			comp[v] = c_cnt++;
+	}
+	return true;
+}
+
+// Вспомогательная функция выделения компоненты вершины pivot. Поиск в ширину
+// выполняется по уровням: потоки делят фронт на равные части, вершины следующего
+// уровня захватываются атомарной установкой бита (1 - прямой поиск, 2 - обратный).
+// Пока фронт меньше PARALLEL_FRONTIER, он обрабатывается в текущем потоке как стек,
+// без синхронизации на каждом уровне. Компонента pivot - вершины, достижимые в
+// обоих направлениях. Перед каждым параллельным уровнем control проверяется
+// сразу, вершина стека последовательной части засчитывается как шаг. Каждая
+// вершина фронта учитывается как раскрытая, ее дуги - как просмотренные.
+template<typename Graph, typename Stats>
+bool SccDecomposition<Graph, Stats>::forward_backward(const CsrGraph &fwd, const CsrGraph &bwd,
+		int pivot, ThreadPool &pool, SearchControl *control)
+{
+	int T = pool.size();
+	unique_ptr<atomic<unsigned char>[]> mark(new atomic<unsigned char>[v_cnt]);
+	vector<vector<int>> local(T);
+	vector<long long> scanned(T);
+	for(int v = 0; v < v_cnt; ++v)
+		mark[v] = 0;
+
+	auto bfs = [&](const CsrGraph &G, unsigned char bit) {
+		vector<int> frontier(1, pivot);
+		mark[pivot] |= bit;
+		while(!frontier.empty()) {
+			if(frontier.size() < PARALLEL_FRONTIER) {
+				if(control && !control->step())
+					return false;
+				int v = frontier.back();
+				frontier.pop_back();
+				stats.expand();
+				stats.scan(G.last(v) - G.first(v));
+				for(int i = G.first(v); i < G.last(v); ++i) {
+					int u = G.target(i);
+					if(comp[u] == -1 && !(mark[u].fetch_or(bit) & bit))
+						frontier.push_back(u);
+				}
+				continue;
+			}
+			if(control && !control->poll())
+				return false;
+			stats.expand(frontier.size());
+			pool.run([&](int t) {
+				local[t].clear();
+				scanned[t] = 0;
+				int n = frontier.size();
+				for(int k = (long long)n * t / T; k < (long long)n * (t + 1) / T; ++k) {
+					scanned[t] += G.last(frontier[k]) - G.first(frontier[k]);
+					for(int i = G.first(frontier[k]); i < G.last(frontier[k]); ++i) {
+						int u = G.target(i);
+						if(comp[u] == -1 && !(mark[u].fetch_or(bit) & bit))
+							local[t].push_back(u);
+					}
+				}
+			});
+			frontier.clear();
+			for(int t = 0; t < T; ++t) {
+				stats.scan(scanned[t]);
+				frontier.insert(frontier.end(), local[t].begin(), local[t].end());
+			}
+		}
+		return true;
+	};
+	if(!bfs(fwd, 1) || !bfs(bwd, 2))
+		return false;
+
+	for(int v = 0; v < v_cnt; ++v)
+		if(mark[v] == 3)
+			comp[v] = c_cnt;
+	++c_cnt;
+	return true;
+}
+
+// Вспомогательная функция построения конденсации. Вершины группируются по компонентам
+// (сортировкой подсчетом), для каждой компоненты просматриваются дуги ее вершин;
+// повторные дуги к одной компоненте объединяются с минимальной стоимостью. При
+// перенумерации компоненты упорядочиваются алгоритмом Кана: компонента, стоящая
+// k-й в топологическом порядке, получает номер components() - 1 - k.
+template<typename Graph, typename Stats>
+void SccDecomposition<Graph, Stats>::condense(const CsrGraph &G, bool renumber) {
+	vector<int> start(c_cnt + 1, 0), order(v_cnt), mark(c_cnt, -1), slot(c_cnt);
+	for(int v = 0; v < v_cnt; ++v)
+		++start[comp[v] + 1];
+	for(int c = 0; c < c_cnt; ++c)
+		start[c + 1] += start[c];
+	vector<int> pos(start.begin(), start.end() - 1);
+	for(int v = 0; v < v_cnt; ++v)
+		order[pos[comp[v]]++] = v;
+
+	vector<Edge> arcs;
+	for(int c = 0; c < c_cnt; ++c)
+		for(int k = start[c]; k < start[c + 1]; ++k)
+			for(int i = G.first(order[k]); i < G.last(order[k]); ++i) {
+				int d = comp[G.target(i)];
+				if(d == c)
+					continue;
+				if(mark[d] != c) {
+					mark[d] = c;
+					slot[d] = arcs.size();
+					arcs.push_back(Edge(c, d, G.cost(i)));
+				} else
+					arcs[slot[d]].c = min(arcs[slot[d]].c, G.cost(i));
+			}
+
+	if(renumber) {
+		vector<int> in(c_cnt, 0), queue, id(c_cnt);
+		vector<int> &first = start;
+		fill(first.begin(), first.end(), 0);
+		for(auto &a : arcs) {
+			++in[a.w];
+			++first[a.v + 1];
+		}
+		for(int c = 0; c < c_cnt; ++c)
+			first[c + 1] += first[c];
+		for(int c = 0; c < c_cnt; ++c)
+			if(in[c] == 0)
+				queue.push_back(c);
+		// Дуги сгруппированы по начальной компоненте в порядке возрастания ее номера.
+		for(size_t h = 0; h < queue.size(); ++h) {
+			int c = queue[h];
+			id[c] = c_cnt - 1 - h;
+			for(int k = first[c]; k < first[c + 1]; ++k)
+				if(--in[arcs[k].w] == 0)
+					queue.push_back(arcs[k].w);
+		}
+		for(int v = 0; v < v_cnt; ++v)
+			comp[v] = id[comp[v]];
+		for(auto &a : arcs)
+			a.v = id[a.v], a.w = id[a.w];
+	}
+
+	dag = CsrGraph(c_cnt, arcs, true);
+	stats.allocate((long long)arcs.size() * 2 * sizeof(int) + (c_cnt + 1LL) * sizeof(int));
+}
+
+// Конструктор. Если разбиение прервано по control, конденсация не строится.
+// Вариант разбиения выполняется вспомогательной функцией decompose().
+template<typename Graph, typename Stats>
+SccDecomposition<Graph, Stats>::SccDecomposition(const Graph &graph, int threads, SearchControl *control) :
+	v_cnt(graph.V()), c_cnt(0), comp(graph.V(), -1), dag(0, vector<Edge>(), true)
+{
+	stats.reset();
+	stats.begin(QueryStats::SETUP);
+	CsrGraph G(graph);
+	stats.allocate((long long)v_cnt * sizeof(int));
+	decompose(G, threads, control);
+	stats.end();
+}
+
+// Вспомогательная функция разбиения графа G. Конденсация строится на этапе
+// восстановления.
+template<typename Graph, typename Stats>
+void SccDecomposition<Graph, Stats>::decompose(const CsrGraph &G, int threads, SearchControl *control) {
+	if(threads == 1) {
+		stats.begin(QueryStats::SEARCH);
+		if(tarjan(G, control)) {
+			stats.begin(QueryStats::RECONSTRUCTION);
+			condense(G, false);
+		}
+		return;
+	}
+
+	CsrGraph bwd = G.reversed();
+	ThreadPool pool(threads);
+	stats.begin(QueryStats::SEARCH);
+	if(!trim(G, bwd, pool, control))
+		return;
+
+	// Опорная вершина - вершина с наибольшим произведением степеней: с большой
+	// вероятностью она принадлежит крупнейшей компоненте.
+	int pivot = -1;
+	long long best = -1;
+	for(int v = 0; v < v_cnt; ++v) {
+		long long p = (long long)(G.last(v) - G.first(v)) * (bwd.last(v) - bwd.first(v));
+		if(comp[v] == -1 && p > best)
+			best = p, pivot = v;
+	}
+	if(pivot != -1 && (!forward_backward(G, bwd, pivot, pool, control) ||
+			!trim(G, bwd, pool, control)))
+		return;
+
+	if(tarjan(G, control)) {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		condense(G, true);
+	}
+}
+
+// Функция возвращает количество компонент сильной связности.
+template<typename Graph, typename Stats>
+int SccDecomposition<Graph, Stats>::components() const { return c_cnt; }
+
+// Функция возвращает номер компоненты вершины v.
+template<typename Graph, typename Stats>
+int SccDecomposition<Graph, Stats>::component(int v) const { return comp[v]; }
+
+// Функция возвращает вектор номеров компонент всех вершин.
+template<typename Graph, typename Stats>
+const vector<int> &SccDecomposition<Graph, Stats>::ids() const { return comp; }
+
+// Функция возвращает конденсацию графа.
+template<typename Graph, typename Stats>
+const CsrGraph &SccDecomposition<Graph, Stats>::condensation() const { return dag; }
+
+// Функция возвращает статистику построения.
+template<typename Graph, typename Stats>
+const Stats &SccDecomposition<Graph, Stats>::statistics() const { return stats; }
@@ -0,0 +1,115 @@
+#ifndef _SCC_DECOMPOSITION_
+#define _SCC_DECOMPOSITION_
+
+#include "main_header.hpp"
+#include "CsrGraph.hpp"
+#include "ThreadPool.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Разбиение графа Graph на компоненты сильной связности (КСС) и построение
+ * конденсации - ациклического графа, вершинами которого являются компоненты.
+ * ~~~~ Примечания:
+ * Все обходы итеративные (явный стек вместо рекурсии), поэтому глубина графа не
+ * ограничена размером стека вызовов. Реализованы два варианта:
+ * 1) threads == 1 - алгоритм Тарьяна, O(V + E);
+ * 2) threads != 1 - параллельный вариант (Hong et al., "On Fast Parallel Detection
+ * of Strongly Connected Components"): отсечение (trimming) вершин без входящих или
+ * без исходящих дуг среди оставшихся (каждая из них - отдельная компонента),
+ * выделение крупнейшей компоненты прямым и обратным параллельным поиском в ширину
+ * из одной вершины (forward-backward) как пересечения достижимых множеств,
+ * повторное отсечение и алгоритм Тарьяна для оставшихся вершин.
+ * Номера компонент в обоих вариантах образуют обратный топологический порядок:
+ * каждая дуга конденсации ведет от компоненты с большим номером к компоненте с
+ * меньшим. Конденсация хранится в виде CsrGraph (ориентированного); стоимость дуги
+ * между компонентами - минимальная стоимость дуги исходного графа между ними.
+ * Разбиение можно прервать (см. SearchControl): условия остановки проверяются
+ * перед каждым раундом отсечения и уровнем поиска в ширину, а в алгоритме Тарьяна
+ * шагом считается посещение вершины. Компоненты, выделенные до остановки, точны,
+ * остальным вершинам соответствует номер -1; конденсация при этом не строится
+ * (пустой граф), а номера компонент параллельного варианта не упорядочиваются.
+ * Stats - политика статистики (см. NoStats, CountingStats) построения: этап
+ * подготовки - CSR-представление графа, поиска - разбиение (раскрытые вершины и
+ * просмотренные дуги обходов и отсечения), восстановления - построение
+ * конденсации. Этапа форматирования нет.
+*/
+template<typename Graph, typename Stats = NoStats>
+class SccDecomposition {
+private:
+	/* Минимальный размер фронта, при котором уровень поиска в ширину обрабатывается параллельно. */
+	static const size_t PARALLEL_FRONTIER = 4096;
+
+	int v_cnt, c_cnt;
+	/* comp[v] - номер компоненты вершины v. */
+	vector<int> comp;
+	CsrGraph dag;
+	/* Статистика построения. */
+	Stats stats;
+
+	/*
+	 * Вспомогательная функция алгоритма Тарьяна для вершин, которым еще не
+	 * назначена компонента (comp[v] == -1); остальные вершины не просматриваются.
+	 * Возвращает false, если обход прерван по control (компоненты вершин,
+	 * посещенных прерванным обходом, не назначаются).
+	*/
+	bool tarjan(const CsrGraph &G, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция параллельного отсечения: вершины без входящих или без
+	 * исходящих дуг среди вершин без компоненты (кроме петель) получают собственные
+	 * компоненты, пока такие вершины есть. Возвращает false, если отсечение не
+	 * выполнялось из-за остановки по control.
+	*/
+	bool trim(const CsrGraph &fwd, const CsrGraph &bwd, ThreadPool &pool, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция выделения компоненты вершины pivot прямым и обратным
+	 * параллельным поиском в ширину по вершинам без компоненты. Возвращает false
+	 * (компонента не назначается), если поиск прерван по control.
+	*/
+	bool forward_backward(const CsrGraph &fwd, const CsrGraph &bwd, int pivot,
+		ThreadPool &pool, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция построения конденсации. Если renumber == true,
+	 * компоненты предварительно перенумеровываются в обратном топологическом порядке.
+	*/
+	void condense(const CsrGraph &G, bool renumber);
+
+	/*
+	 * Вспомогательная функция разбиения CSR-представления G на компоненты и
+	 * построения конденсации (threads и control - см. конструктор).
+	*/
+	void decompose(const CsrGraph &G, int threads, SearchControl *control);
+public:
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; threads - количество потоков (1 - алгоритм Тарьяна, иначе
+	 * параллельный вариант; threads <= 0 - по количеству аппаратных потоков);
+	 * control - управление разбиением (nullptr - без ограничений).
+	*/
+	SccDecomposition(const Graph &G, int threads = 1, SearchControl *control = nullptr);
+
+	/* Функция возвращает количество компонент сильной связности (выделенных до остановки). */
+	inline int components() const;
+
+	/* Функция возвращает номер компоненты вершины v (-1, если компонента не выделена). */
+	inline int component(int v) const;
+
+	/* Функция возвращает вектор номеров компонент всех вершин. */
+	inline const vector<int> &ids() const;
+
+	/*
+	 * Функция возвращает конденсацию: ориентированный граф на components() вершинах,
+	 * содержащий дугу (a, b), если в исходном графе есть дуга из компоненты a в b.
+	*/
+	inline const CsrGraph &condensation() const;
+
+	/* Функция возвращает статистику построения. */
+	inline const Stats &statistics() const;
+};
+
+#endif // _SCC_DECOMPOSITION_
@@ -0,0 +1,88 @@
+#include "SearchControl.hpp"
+
+// Вспомогательная функция перевода в состояние s. Первая причина остановки
+// сохраняется: состояние изменяется, только если поиск еще не остановлен.
+void SearchControl::stop(status s) {
+	int expected = COMPLETE;
+	state.compare_exchange_strong(expected, s);
+}
+
+// Конструктор.
+SearchControl::SearchControl(int period) :
+	period(max(period, 1)), countdown(max(period, 1)), limit(-1), results(0), timed(false),
+	cancelled(false), state(COMPLETE) { }
+
+// Функция отмены поиска.
+void SearchControl::cancel() { cancelled = true; }
+
+// Функции установки крайнего срока.
+void SearchControl::set_deadline(chrono::steady_clock::time_point t) {
+	deadline = t;
+	timed = true;
+}
+
+void SearchControl::set_timeout(long long ms) {
+	set_deadline(chrono::steady_clock::now() + chrono::milliseconds(ms));
+}
+
+// Функция установки ограничения количества результатов.
+void SearchControl::set_limit(long long n) { limit = n; }
+
+// Функция учета шага поиска. Между проверками только уменьшается счетчик;
+// остановка, зафиксированная ранее, видна через состояние.
+bool SearchControl::step() {
+	if(--countdown > 0)
+		return state.load(memory_order_relaxed) == COMPLETE;
+	countdown = period;
+	return poll();
+}
+
+// Функция немедленной проверки условий остановки.
+bool SearchControl::poll() {
+	if(state.load(memory_order_relaxed) != COMPLETE)
+		return false;
+	if(cancelled.load(memory_order_relaxed))
+		stop(CANCELLED);
+	else if(timed && chrono::steady_clock::now() >= deadline)
+		stop(DEADLINE_EXCEEDED);
+	return state == COMPLETE;
+}
+
+// Функция учета найденного результата.
+bool SearchControl::found() {
+	if(++results < limit || limit < 0)
+		return true;
+	stop(TRUNCATED);
+	return false;
+}
+
+// Функция проверки остановки поиска.
+bool SearchControl::stopped() const { return state.load(memory_order_relaxed) != COMPLETE; }
+
+// Функция возвращает состояние поиска.
+SearchControl::status SearchControl::result() const { return (status)state.load(); }
+
+// Функция возвращает количество засчитанных результатов.
+long long SearchControl::count() const { return results; }
+
+// Функция сброса состояния.
+void SearchControl::reset() {
+	countdown = period;
+	results = 0;
+	cancelled = false;
+	state = COMPLETE;
+}
+
+// Функция возвращает название состояния.
+string SearchControl::name(status s) {
+	switch(s) {
+	case COMPLETE:
+		return "complete";
+	case TRUNCATED:
+		return "truncated";
+	case CANCELLED:
+		return "cancelled";
+	default:
+		return "deadline exceeded";
+	}
+}
@@ -0,0 +1,101 @@
+#ifndef _SEARCH_CONTROL_
+#define _SEARCH_CONTROL_
+
+#include "main_header.hpp"
+
+#include <chrono>
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Управление выполнением поиска: отмена, крайний срок и ограничение количества
+ * результатов. Передается необязательным параметром запросам всех классов поиска
+ * и конструкторам классов с предварительной обработкой (ShortestPathSearcher,
+ * AllPairsSearcher, AltSearcher, ContractionHierarchy, SccDecomposition,
+ * ReachabilityIndex).
+ * ~~~~ Примечания:
+ * Поиск вызывает step() на каждом шаге (раскрытии вершины, корзине очереди) и
+ * found() для каждого найденного результата; флаг отмены и часы проверяются
+ * только каждые period шагов, поэтому накладные расходы - одно уменьшение
+ * счетчика на шаг. Поиски с крупными шагами (фазы алгоритма Флойда, строки
+ * матриц, корзины delta-stepping, группы BatchSearcher, сжатие вершины
+ * ContractionHierarchy, раунды SccDecomposition) вызывают poll(), который
+ * проверяет условия сразу. Остановленный поиск возвращает то, что найдено до
+ * остановки: перечисляющие поиски - уже найденные пути, предварительная
+ * обработка - частичный результат, описанный в классе (невычисленные строки,
+ * ядро иерархии, вершины без компоненты), запрос одного пути - отсутствие пути.
+ * Причина остановки - result():
+ * COMPLETE - поиск завершен полностью;
+ * TRUNCATED - достигнуто ограничение количества результатов (set_limit());
+ * CANCELLED - вызван cancel();
+ * DEADLINE_EXCEEDED - наступил крайний срок (set_deadline(), set_timeout()).
+ * Метод cancel() можно вызывать из любого потока; step() и found() - только из
+ * потока, выполняющего поиск; poll() - из нескольких потоков одного поиска.
+ * После остановки все проверки возвращают false до вызова reset().
+*/
+class SearchControl {
+public:
+	/* Состояние (результат) поиска. */
+	enum status { COMPLETE, TRUNCATED, CANCELLED, DEADLINE_EXCEEDED };
+private:
+	int period, countdown;
+	long long limit, results;
+	bool timed;
+	chrono::steady_clock::time_point deadline;
+	atomic<bool> cancelled;
+	atomic<int> state;
+
+	/* Вспомогательная функция перевода в состояние s (если поиск еще не остановлен). */
+	void stop(status s);
+public:
+	/*
+	 * Конструктор. period - количество шагов между проверками флага отмены и
+	 * крайнего срока в step().
+	*/
+	SearchControl(int period = 1024);
+
+	/* Функция отмены поиска. Потокобезопасна. */
+	void cancel();
+
+	/* Функции установки крайнего срока: момента времени t либо через ms миллисекунд. */
+	void set_deadline(chrono::steady_clock::time_point t);
+	void set_timeout(long long ms);
+
+	/* Функция установки ограничения количества результатов n (n < 0 - без ограничения). */
+	void set_limit(long long n);
+
+	/*
+	 * Функция учета шага поиска. Возвращает false, если поиск нужно остановить.
+	 * Условия остановки проверяются каждые period вызовов.
+	*/
+	inline bool step();
+
+	/* Функция немедленной проверки условий остановки. Возвращает false, если поиск нужно остановить. */
+	bool poll();
+
+	/*
+	 * Функция учета найденного результата. Возвращает false, если достигнуто
+	 * ограничение количества результатов (результат при этом засчитывается).
+	*/
+	bool found();
+
+	/* Функция проверки остановки поиска. */
+	inline bool stopped() const;
+
+	/* Функция возвращает состояние поиска. */
+	inline status result() const;
+
+	/* Функция возвращает количество засчитанных результатов. */
+	inline long long count() const;
+
+	/*
+	 * Функция сброса состояния, счетчиков и флага отмены для следующего поиска
+	 * (либо продолжения остановленного обхода PathGenerator). Крайний срок и
+	 * ограничение количества результатов сохраняются.
+	*/
+	void reset();
+
+	/* Функция возвращает название состояния s ("complete", "truncated" и т.д.). */
+	static string name(status s);
+};
+
+#endif // _SEARCH_CONTROL_
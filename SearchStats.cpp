@@ -0,0 +1,120 @@
+#include "SearchStats.hpp"
+
+// Конструктор.
+QueryStats::QueryStats() : expanded(0), scanned(0), lookups(0), paths(0), bytes(0) {
+	fill(phase_ns, phase_ns + PHASES, 0);
+}
+
+// Функция сложения статистик.
+QueryStats &QueryStats::operator+=(const QueryStats &s) {
+	expanded += s.expanded;
+	scanned += s.scanned;
+	lookups += s.lookups;
+	paths += s.paths;
+	bytes += s.bytes;
+	for(int p = 0; p < PHASES; ++p)
+		phase_ns[p] += s.phase_ns[p];
+	return *this;
+}
+
+// Функция возвращает название этапа.
+string QueryStats::name(phase p) {
+	switch(p) {
+	case SETUP:
+		return "setup";
+	case SEARCH:
+		return "search";
+	case RECONSTRUCTION:
+		return "reconstruction";
+	default:
+		return "formatting";
+	}
+}
+
+// Функция возвращает статистику в виде одной строки "ключ=значение".
+string QueryStats::to_string() const {
+	string res = "expanded=" + std::to_string(expanded) + " scanned=" + std::to_string(scanned) +
+		" lookups=" + std::to_string(lookups) + " paths=" + std::to_string(paths) +
+		" bytes=" + std::to_string(bytes);
+	for(int p = 0; p < PHASES; ++p)
+		res += " " + name((phase)p) + "_ns=" + std::to_string(phase_ns[p]);
+	return res;
+}
+
+// Конструктор.
+CountingStats::CountingStats() : current(QueryStats::PHASES) { }
+
+// Функции учета событий поиска.
+void CountingStats::expand(long long n) { s.expanded += n; }
+
+void CountingStats::scan(long long n) { s.scanned += n; }
+
+void CountingStats::lookup() { ++s.lookups; }
+
+void CountingStats::path() { ++s.paths; }
+
+void CountingStats::allocate(long long bytes) { s.bytes += bytes; }
+
+// Функция начала этапа p. Время текущего этапа добавляется к его сумме.
+void CountingStats::begin(QueryStats::phase p) {
+	end();
+	current = p;
+	start = chrono::steady_clock::now();
+}
+
+// Функция завершения текущего этапа.
+void CountingStats::end() {
+	if(current == QueryStats::PHASES)
+		return;
+	s.phase_ns[current] += chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now() - start).count();
+	current = QueryStats::PHASES;
+}
+
+// Функция сброса статистики.
+void CountingStats::reset() {
+	s = QueryStats();
+	current = QueryStats::PHASES;
+}
+
+// Функция возвращает собранную статистику.
+const QueryStats &CountingStats::get() const { return s; }
+
+// Конструктор.
+StatsAggregator::StatsAggregator() : queries(0) { }
+
+// Функции добавления статистики одного запроса.
+void StatsAggregator::add(const QueryStats &s) {
+	lock_guard<mutex> guard(lock);
+	total += s;
+	++queries;
+}
+
+void StatsAggregator::add(const CountingStats &s) { add(s.get()); }
+
+void StatsAggregator::add(const NoStats &) { }
+
+// Функция возвращает сумму добавленных статистик.
+QueryStats StatsAggregator::sum() const {
+	lock_guard<mutex> guard(lock);
+	return total;
+}
+
+// Функция возвращает количество добавленных запросов.
+long long StatsAggregator::count() const {
+	lock_guard<mutex> guard(lock);
+	return queries;
+}
+
+// Функция возвращает сумму статистик в виде одной строки.
+string StatsAggregator::report() const {
+	lock_guard<mutex> guard(lock);
+	return "queries=" + std::to_string(queries) + " " + total.to_string();
+}
+
+// Функция сброса накопленной статистики.
+void StatsAggregator::reset() {
+	lock_guard<mutex> guard(lock);
+	total = QueryStats();
+	queries = 0;
+}
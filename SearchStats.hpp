@@ -0,0 +1,140 @@
+#ifndef _SEARCH_STATS_
+#define _SEARCH_STATS_
+
+#include "main_header.hpp"
+
+#include <chrono>
+
+/*
+ * ~~~~ Описание структуры:
+ * Статистика одного запроса (либо сумма статистик нескольких запросов):
+ * expanded - количество раскрытых вершин (вершин, смежные с которыми просмотрены);
+ * scanned - количество просмотренных дуг (шагов итераторов смежных вершин);
+ * lookups - количество вызовов edge() графа;
+ * paths - количество найденных путей;
+ * bytes - объем памяти, выделенной под результаты и крупные буферы (строки путей,
+ * векторы путей, деревья кратчайших путей), в байтах;
+ * phase_ns - время этапов запроса в наносекундах.
+*/
+struct QueryStats {
+	/* Этапы запроса: подготовка, поиск, восстановление пути, форматирование ответа. */
+	enum phase { SETUP, SEARCH, RECONSTRUCTION, FORMATTING, PHASES };
+
+	long long expanded, scanned, lookups, paths, bytes;
+	long long phase_ns[PHASES];
+
+	QueryStats();
+
+	/* Функция сложения статистик. */
+	QueryStats &operator+=(const QueryStats &s);
+
+	/* Функция возвращает название этапа p ("setup", "search" и т.д.). */
+	static string name(phase p);
+
+	/*
+	 * Функция возвращает статистику в формате "expanded=N scanned=N ... setup_ns=N
+	 * search_ns=N ..." (одна строка, удобна для экспорта метрик).
+	*/
+	string to_string() const;
+};
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Политика статистики по умолчанию для классов поиска и CountingGraph:
+ * статистика не собирается.
+ * ~~~~ Примечания:
+ * Все методы пусты и встраиваются, поэтому поиск с NoStats компилируется в тот же
+ * код, что и без статистики. Интерфейс совпадает с CountingStats.
+*/
+class NoStats {
+public:
+	inline void expand(long long = 1) { }
+	inline void scan(long long = 1) { }
+	inline void lookup() { }
+	inline void path() { }
+	inline void allocate(long long) { }
+	inline void begin(QueryStats::phase) { }
+	inline void end() { }
+	inline void reset() { }
+};
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Политика статистики, собирающая счетчики и время этапов запроса (см. QueryStats).
+ * ~~~~ Примечания:
+ * Класс поиска сбрасывает статистику в начале каждого запроса, поэтому после
+ * запроса get() содержит данные только этого запроса. Время этапа измеряется от
+ * вызова begin() до следующего вызова begin() или end(). Экземпляр не
+ * потокобезопасен: статистика нескольких потоков суммируется StatsAggregator.
+*/
+class CountingStats {
+private:
+	QueryStats s;
+	/* Текущий этап (PHASES - этап не начат) и момент его начала. */
+	QueryStats::phase current;
+	chrono::steady_clock::time_point start;
+public:
+	CountingStats();
+
+	/*
+	 * Функции учета раскрытия вершины, просмотра дуги (n - количество сразу, например
+	 * сумма счетчиков потоков параллельного поиска), вызова edge() и найденного пути.
+	*/
+	inline void expand(long long n = 1);
+	inline void scan(long long n = 1);
+	inline void lookup();
+	inline void path();
+
+	/* Функция учета выделения bytes байт. */
+	inline void allocate(long long bytes);
+
+	/* Функция начала этапа p (текущий этап, если он начат, завершается). */
+	void begin(QueryStats::phase p);
+
+	/* Функция завершения текущего этапа. */
+	void end();
+
+	/* Функция сброса статистики. */
+	void reset();
+
+	/* Функция возвращает собранную статистику. */
+	inline const QueryStats &get() const;
+};
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Потокобезопасный накопитель статистики запросов нескольких потоков (например,
+ * рабочих потоков сервера) для экспорта метрик.
+ * ~~~~ Примечания:
+ * Каждый поток собирает статистику своих запросов в собственном экземпляре класса
+ * поиска и добавляет ее после запроса методом add(): блокировка захватывается один
+ * раз на запрос, а не на каждый счетчик. Статистика NoStats игнорируется, поэтому
+ * вызовы add() можно оставлять в коде, параметризованном политикой.
+*/
+class StatsAggregator {
+private:
+	mutable mutex lock;
+	QueryStats total;
+	long long queries;
+public:
+	StatsAggregator();
+
+	/* Функции добавления статистики одного запроса. */
+	void add(const QueryStats &s);
+	inline void add(const CountingStats &s);
+	inline void add(const NoStats &);
+
+	/* Функция возвращает сумму добавленных статистик. */
+	QueryStats sum() const;
+
+	/* Функция возвращает количество добавленных запросов. */
+	long long count() const;
+
+	/* Функция возвращает сумму в формате QueryStats::to_string() с префиксом "queries=N ". */
+	string report() const;
+
+	/* Функция сброса накопленной статистики. */
+	void reset();
+};
+
+#endif // _SEARCH_STATS_
@@ -2,62 +2,417 @@
 
 /* Прим.: алгоритм неэффективен для решаемой задачи!!! Создан класс BreadthFirstSearcher! */
 
-// Вспомогательная функция, возвращающая путь из промежуточных вершин полного
-// пути от вершины v до вершины w в строке вида -k1-k2...-kn, где k1, ..., kn -
-// вершины графа G в кратчайшем пути v-k1-k2-...-kn-w. Используется функцией
-// get_path().
-template<typename Graph>
-string ShortestPathSearcher<Graph>::trace(int v, int w) const {
-	int k = sp_tracer[v][w];
-	if(k == 0)
-		return "";
-	return trace(v, k) + "-" + to_string(k) + trace(k, w);
-}
-
-// Конструктор. Строит матрицу смежности sp_matrix для графа G, проверяя
-// каждое его ребро, и далее корректирует ее по алгоритму Флойда поиска
-// кратчайших путей, также строит матрицу трассировки путей sp_tracer для
-// возможности просмотра полного пути, помимо стоимости этого пути.
-template<typename Graph>
-ShortestPathSearcher<Graph>::ShortestPathSearcher(const Graph &G) :
-	sp_tracer(G.V()), sp_matrix(G.V()), v_cnt(G.V())
+// Ядро алгоритма: релаксация строки d через вершину k. Вместо условного перехода
+// используется маска: элементы dk, равные INF_COST, и элементы, для которых путь
+// через k не короче, не изменяются. Векторная часть обрабатывает по 16 (AVX-512),
+// 8 (AVX2) или 4 (SSE2) элемента, остаток (при его наличии) - скалярный цикл.
+template<typename Graph, typename Stats>
+void ShortestPathSearcher<Graph, Stats>::relax_row(int *d, int *tr, const int *dk,
+		int dik, int k, int n)
 {
-	for(int i = 0; i < v_cnt; ++i) {
-		sp_tracer[i].assign(v_cnt, 0);
-		sp_matrix[i].assign(v_cnt, 0);
+	int j = 0;
+#if defined(__AVX512F__)
+	const __m512i vdik = _mm512_set1_epi32(dik), vk = _mm512_set1_epi32(k),
+		vinf = _mm512_set1_epi32(INF_COST);
+	for(; j + 16 <= n; j += 16) {
+		__m512i b = _mm512_loadu_si512(dk + j);
+		__m512i s = _mm512_add_epi32(b, vdik);
+		__mmask16 m = _mm512_mask_cmplt_epi32_mask(_mm512_cmplt_epi32_mask(b, vinf),
+			s, _mm512_loadu_si512(d + j));
+		_mm512_mask_storeu_epi32(d + j, m, s);
+		_mm512_mask_storeu_epi32(tr + j, m, vk);
+	}
+#elif defined(__AVX2__)
+	const __m256i vdik = _mm256_set1_epi32(dik), vk = _mm256_set1_epi32(k),
+		vinf = _mm256_set1_epi32(INF_COST);
+	for(; j + 8 <= n; j += 8) {
+		__m256i b = _mm256_loadu_si256((const __m256i *)(dk + j));
+		__m256i c = _mm256_loadu_si256((const __m256i *)(d + j));
+		__m256i t = _mm256_loadu_si256((const __m256i *)(tr + j));
+		__m256i s = _mm256_add_epi32(b, vdik);
+		__m256i m = _mm256_and_si256(_mm256_cmpgt_epi32(vinf, b), _mm256_cmpgt_epi32(c, s));
+		_mm256_storeu_si256((__m256i *)(d + j), _mm256_blendv_epi8(c, s, m));
+		_mm256_storeu_si256((__m256i *)(tr + j), _mm256_blendv_epi8(t, vk, m));
+	}
+#elif defined(__SSE2__)
+	const __m128i vdik = _mm_set1_epi32(dik), vk = _mm_set1_epi32(k),
+		vinf = _mm_set1_epi32(INF_COST);
+	for(; j + 4 <= n; j += 4) {
+		__m128i b = _mm_loadu_si128((const __m128i *)(dk + j));
+		__m128i c = _mm_loadu_si128((const __m128i *)(d + j));
+		__m128i t = _mm_loadu_si128((const __m128i *)(tr + j));
+		__m128i s = _mm_add_epi32(b, vdik);
+		__m128i m = _mm_and_si128(_mm_cmpgt_epi32(vinf, b), _mm_cmpgt_epi32(c, s));
+		_mm_storeu_si128((__m128i *)(d + j), _mm_or_si128(_mm_and_si128(m, s), _mm_andnot_si128(m, c)));
+		_mm_storeu_si128((__m128i *)(tr + j), _mm_or_si128(_mm_and_si128(m, vk), _mm_andnot_si128(m, t)));
+	}
+#endif
+	for(; j < n; ++j) {
+		int s = (dk[j] < INF_COST ? dik + dk[j] : INF_COST);
+		bool m = s < d[j];
+		d[j] = (m ? s : d[j]);
+		tr[j] = (m ? k : tr[j]);
+	}
+}
+
+// Вспомогательная функция релаксации плитки (ci, cj) через вершины блока kb:
+// для каждой вершины k блока kb и каждой строки i плитки выполняется
+// d[i][cj..] = min(d[i][cj..], d[i][k] + d[k][cj..]). Проверка d[i][k] на
+// бесконечность вынесена из внутреннего цикла.
+template<typename Graph, typename Stats>
+void ShortestPathSearcher<Graph, Stats>::relax_tile(int ci, int cj, int kb) {
+	int i0 = ci * BLOCK, j0 = cj * BLOCK, k0 = kb * BLOCK;
+	for(int k = k0; k < k0 + BLOCK; ++k) {
+		const int *dk = &sp_matrix[k * stride + j0];
+		for(int i = i0; i < i0 + BLOCK; ++i) {
+			int dik = sp_matrix[i * stride + k];
+			if(dik >= INF_COST)
+				continue;
+			relax_row(&sp_matrix[i * stride + j0], &sp_tracer[i * stride + j0], dk, dik, k, BLOCK);
+		}
+	}
+}
+
+// Блочный алгоритм Флойда. Фазы 2 и 3 для каждого блока kb распределяются между
+// потоками пула: плитки каждой фазы независимы друг от друга, так как читают
+// только плитки строки и столбца kb, окончательные после предыдущей фазы.
+// Остановка по control проверяется между блоками: после блока kb матрицы содержат
+// кратчайшие пути с промежуточными вершинами из блоков 0, ..., kb.
+template<typename Graph, typename Stats>
+void ShortestPathSearcher<Graph, Stats>::floyd(int threads, SearchControl *control) {
+	int nb = stride / BLOCK;
+	if(nb == 1) {
+		relax_tile(0, 0, 0);
+		stats.expand(v_cnt);
+		return;
 	}
+
+	ThreadPool pool(min(threads > 0 ? threads : (int)thread::hardware_concurrency(), nb));
+	int T = pool.size();
+	for(int kb = 0; kb < nb; ++kb) {
+		if(control && !control->poll())
+			return;
+
+		// Фаза 1: диагональная плитка.
+		relax_tile(kb, kb, kb);
+
+		// Фаза 2: плитки строки и столбца kb.
+		pool.run([&](int t) {
+			for(int b = t; b < nb; b += T)
+				if(b != kb) {
+					relax_tile(kb, b, kb);
+					relax_tile(b, kb, kb);
+				}
+		});
+
+		// Фаза 3: остальные плитки, распределенные между потоками по строкам плиток.
+		pool.run([&](int t) {
+			for(int bi = t; bi < nb; bi += T)
+				if(bi != kb)
+					for(int bj = 0; bj < nb; ++bj)
+						if(bj != kb)
+							relax_tile(bi, bj, kb);
+		});
+		stats.expand(min((int)BLOCK, v_cnt - kb * BLOCK));
+	}
+}
+
+// Вспомогательная функция вычисления строк матриц ациклического графа. Строка i -
+// результат прохода DagSearcher::sweep() из вершины i; предок вершины j на пути
+// из i записывается в матрицу трассировки как вершина, разбивающая путь i-j на
+// пути i-k и k-j (ребро k-j), а предок i - как -1 (путь из одного ребра).
+// Потоки подсчитывают вычисленные строки отдельно; счетчики суммируются после
+// завершения пула.
+template<typename Graph, typename Stats>
+void ShortestPathSearcher<Graph, Stats>::sweep_rows(const DagSearcher<Graph> &dag, SearchControl *control) {
+	auto row = [&](int i) {
+		if(control && !control->poll())
+			return false;
+		int *d = &sp_matrix[i * stride], *tr = &sp_tracer[i * stride];
+		dag.sweep(i, DagSearcher<Graph>::SHORTEST, d, tr);
+		for(int j = 0; j < v_cnt; ++j)
+			if(tr[j] == i)
+				tr[j] = -1;
+		return true;
+	};
+
+	int T = min(threads > 0 ? threads : (int)thread::hardware_concurrency(), v_cnt);
+	if(T <= 1) {
+		for(int i = 0; i < v_cnt; ++i)
+			stats.expand(row(i));
+		return;
+	}
+
+	ThreadPool pool(T);
+	vector<long long> done(T, 0);
+	pool.run([&](int t) {
+		for(int i = t; i < v_cnt; i += T)
+			done[t] += row(i);
+	});
+	for(long long n : done)
+		stats.expand(n);
+}
+
+// Вспомогательная функция построения матриц: составляет матрицу смежности
+// sp_matrix для графа G, проходя по спискам смежных вершин, и далее корректирует
+// ее по блочному алгоритму Флойда поиска кратчайших путей, также строит матрицу
+// трассировки путей sp_tracer для возможности просмотра полного пути, помимо
+// стоимости этого пути. Если ориентированный граф ацикличен, алгоритм Флойда
+// заменяется проходами в топологическом порядке (см. sweep_rows()).
+template<typename Graph, typename Stats>
+void ShortestPathSearcher<Graph, Stats>::build(SearchControl *control) {
+	fill(sp_matrix.begin(), sp_matrix.end(), INF_COST);
+	fill(sp_tracer.begin(), sp_tracer.end(), -1);
+	negative = false;
+
 	// Составление матрицы смежности из графа G
-	for(int i = 0; i < v_cnt; ++i)
-		for(int j = 0; j < v_cnt; ++j) {
-			if(i == j)
-				sp_matrix[i][j] = 0;
-			else
-				sp_matrix[i][j] = G.edge(i, j);
+	stats.begin(QueryStats::SETUP);
+	for(int i = 0; i < v_cnt; ++i) {
+		typename Graph::adjIterator iter(G, i);
+		for(int j = iter.begin(); !iter.end(); j = iter.next()) {
+			stats.scan();
+			sp_matrix[i * stride + j] = iter.cost();
+			negative |= iter.cost() < 0;
 		}
+		sp_matrix[i * stride + i] = 0;
+	}
+	stats.begin(QueryStats::SEARCH);
 
-	// Алгоритм Флойда поиска кратчайших путей.
-	for(int k = 0; k < v_cnt; ++k) {
-		for(int i = 0; i < v_cnt; ++i) {
-			for(int j = 0; j < v_cnt; ++j) {
-				if(sp_matrix[i][k] != 0 && sp_matrix[k][j] != 0 &&
-					(sp_matrix[i][k] + sp_matrix[k][j] < sp_matrix[i][j] ||
-						sp_matrix[i][j] == 0 && i != j))
-				{
-					sp_matrix[i][j] = sp_matrix[i][k] + sp_matrix[k][j];
-					sp_tracer[i][j] = k;
+	// Ациклический граф: строки вычисляются проходами в топологическом порядке.
+	if(G.directed()) {
+		DagSearcher<Graph> dag(G);
+		if(dag.acyclic()) {
+			sweep_rows(dag, control);
+			return;
+		}
+	}
+
+	// Блочный алгоритм Флойда поиска кратчайших путей.
+	floyd(threads, control);
+}
+
+// Вспомогательная функция обновления матриц после добавления (удешевления) дуги
+// (a, b) стоимостью c. Новый кратчайший путь из i в j, если он появился, имеет вид
+// i-...-a-b-...-j, поэтому для каждой строки i выполняется релаксация строки b
+// через вершину a: d[i][j] = min(d[i][j], d[i][a] + c + d[b][j]) - то же ядро
+// relax_row(), что и в алгоритме Флойда. Строка b и столбец a при этом не
+// изменяются (иначе в графе был бы цикл отрицательной стоимости), поэтому
+// обновление выполняется на месте за O(V^2).
+template<typename Graph, typename Stats>
+void ShortestPathSearcher<Graph, Stats>::insert_arc(int a, int b, int c) {
+	negative |= c < 0;
+	if(sp_matrix[a * stride + b] <= c)
+		return;
+
+	const int *db = &sp_matrix[b * stride];
+	for(int i = 0; i < v_cnt; ++i) {
+		int dia = sp_matrix[i * stride + a];
+		if(dia >= INF_COST)
+			continue;
+		stats.expand();
+		// Для строки a путь разбивается вершиной b (a-b и b-...-j), для остальных -
+		// вершиной a (i-...-a и a-b-...-j).
+		relax_row(&sp_matrix[i * stride], &sp_tracer[i * stride], db, dia + c,
+			i == a ? b : a, v_cnt);
+	}
+	sp_tracer[a * stride + b] = -1;
+}
+
+// Вспомогательная функция пересчета строк rows поиском Дейкстры в текущем графе.
+// Строки распределяются между потоками пула. Матрица трассировки заполняется по
+// дереву кратчайших путей: путь i-...-j разбивается предком p вершины j на пути
+// i-...-p и p-j (-1, если предком является сама вершина i). Раскрытые вершины и
+// просмотренные дуги подсчитываются каждым потоком отдельно.
+template<typename Graph, typename Stats>
+void ShortestPathSearcher<Graph, Stats>::recompute_rows(const vector<int> &rows) {
+	auto dijkstra = [&](int i, DaryHeap<4> &heap, long long &expanded, long long &scanned) {
+		int *d = &sp_matrix[i * stride], *tr = &sp_tracer[i * stride];
+		fill(d, d + v_cnt, INF_COST);
+		fill(tr, tr + v_cnt, -1);
+		d[i] = 0;
+		heap.push(i, 0);
+		while(!heap.empty()) {
+			int u = heap.pop();
+			++expanded;
+			typename Graph::adjIterator iter(G, u);
+			for(int x = iter.begin(); !iter.end(); x = iter.next(), ++scanned)
+				if(d[u] + iter.cost() < d[x]) {
+					d[x] = d[u] + iter.cost();
+					tr[x] = (u == i ? -1 : u);
+					heap.push(x, d[x]);
 				}
-			} // for
-		} // for
-	} // for
+		}
+	};
+
+	int T = min(threads > 0 ? threads : (int)thread::hardware_concurrency(), (int)rows.size());
+	if(T <= 1) {
+		DaryHeap<4> heap(v_cnt);
+		long long expanded = 0, scanned = 0;
+		for(int i : rows)
+			dijkstra(i, heap, expanded, scanned);
+		stats.expand(expanded);
+		stats.scan(scanned);
+		return;
+	}
+
+	ThreadPool pool(T);
+	vector<long long> expanded(T, 0), scanned(T, 0);
+	pool.run([&](int t) {
+		DaryHeap<4> heap(v_cnt);
+		for(size_t r = t; r < rows.size(); r += T)
+			dijkstra(rows[r], heap, expanded[t], scanned[t]);
+	});
+	for(int t = 0; t < T; ++t) {
+		stats.expand(expanded[t]);
+		stats.scan(scanned[t]);
+	}
+}
+
+// Вспомогательная функция обработки изменения дуги (v, w) графа G.
+// Добавление и удешевление дуги обрабатываются функцией insert_arc(). При удалении
+// и удорожании дуги пересчитываются только строки i, в которых дуга лежала на
+// кратчайшем пути, то есть d[i][v] + old_c == d[i][w]: остальные строки от нее не
+// зависят. Поиск Дейкстры неприменим к отрицательным стоимостям, поэтому при их
+// наличии матрицы строятся заново.
+template<typename Graph, typename Stats>
+void ShortestPathSearcher<Graph, Stats>::update(int v, int w, int old_c, int new_c) {
+	if(new_c != 0 && (old_c == 0 || new_c < old_c)) {
+		insert_arc(v, w, new_c);
+		return;
+	}
+	if(old_c == 0 || new_c == old_c)
+		return;
+	if(negative) {
+		build();
+		return;
+	}
+
+	vector<int> rows;
+	for(int i = 0; i < v_cnt; ++i) {
+		int div = sp_matrix[i * stride + v];
+		if(div < INF_COST && div + old_c == sp_matrix[i * stride + w])
+			rows.push_back(i);
+	}
+	recompute_rows(rows);
+}
+
+// Функция обработки изменения дуги (v, w) графа G (см. GraphObserver).
+template<typename Graph, typename Stats>
+void ShortestPathSearcher<Graph, Stats>::edge_changed(int v, int w, int old_c, int new_c) {
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	update(v, w, old_c, new_c);
+	stats.end();
+}
 
+// Конструктор. Строит матрицы (см. build()) и подписывается на изменения графа G.
+template<typename Graph, typename Stats>
+ShortestPathSearcher<Graph, Stats>::ShortestPathSearcher(const Graph &G, int threads,
+		SearchControl *control) :
+	v_cnt(G.V()), stride(max(1, (G.V() + BLOCK - 1) / BLOCK) * BLOCK),
+	sp_tracer(stride * stride, -1), sp_matrix(stride * stride, INF_COST),
+	G(G), threads(threads), negative(false)
+{
+	stats.reset();
+	stats.allocate(2LL * stride * stride * sizeof(int));
+	build(control);
+	stats.end();
+	G.subscribe(this);
+}
+
+// Деструктор. Отписывается от изменений графа G.
+template<typename Graph, typename Stats>
+ShortestPathSearcher<Graph, Stats>::~ShortestPathSearcher() { G.unsubscribe(this); }
+
+// Функция возвращает стоимость кратчайшего пути от вершины v до вершины w
+// либо INF_COST, если пути не существует.
+template<typename Graph, typename Stats>
+int ShortestPathSearcher<Graph, Stats>::distance(int v, int w) const {
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	int d = sp_matrix[v * stride + w];
+	stats.end();
+	return d;
+}
+
+// Функция возвращает вершину, предшествующую w на кратчайшем пути от v. Путь v-w
+// разбивается промежуточной вершиной k на пути v-k и k-w, поэтому предшественник
+// w на пути v-w совпадает с предшественником на пути k-w; спуск продолжается,
+// пока путь не станет одним ребром.
+template<typename Graph, typename Stats>
+int ShortestPathSearcher<Graph, Stats>::predecessor(int v, int w) const {
+	if(v == w || sp_matrix[v * stride + w] == INF_COST)
+		return -1;
+	for(int k = sp_tracer[v * stride + w]; k != -1; k = sp_tracer[v * stride + w])
+		v = k;
+	return v;
+}
+
+// Вспомогательная функция восстановления существующего пути от вершины v до
+// вершины w по матрице трассировки (этап восстановления).
+template<typename Graph, typename Stats>
+vector<int> ShortestPathSearcher<Graph, Stats>::trace(int v, int w) const {
+	stats.begin(QueryStats::RECONSTRUCTION);
+	vector<int> res;
+	PathTracer::from_splits(sp_tracer.data(), stride, v, w, res);
+	stats.path();
+	stats.allocate(res.size() * sizeof(int));
+	return res;
+}
+
+// Функция записывает кратчайший путь от вершины v до вершины w в буфер buf
+// (см. PathTracer::from_splits()).
+template<typename Graph, typename Stats>
+int ShortestPathSearcher<Graph, Stats>::path(int v, int w, int *buf, int capacity) const {
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	int n = 0;
+	if(sp_matrix[v * stride + w] != INF_COST) {
+		stats.begin(QueryStats::RECONSTRUCTION);
+		n = PathTracer::from_splits(sp_tracer.data(), stride, v, w, buf, capacity);
+		if(n > 0)
+			stats.path();
+	}
+	stats.end();
+	return n;
+}
+
+// Функция возвращает кратчайший путь от вершины v до вершины w в виде вектора.
+template<typename Graph, typename Stats>
+vector<int> ShortestPathSearcher<Graph, Stats>::path(int v, int w) const {
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	vector<int> res;
+	if(sp_matrix[v * stride + w] != INF_COST)
+		res = trace(v, w);
+	stats.end();
+	return res;
 }
 
 // Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
 // w и его стоимостью в формате: "v-k1-k2-...-kn-w, P", где k1, ..., kn -
 // промежуточные вершины графа G на пути от вершины v до вершины w по кратчайшему
 // пути, а P - стоимость полного кратчайшего пути.
-template<typename Graph>
-string ShortestPathSearcher<Graph>::get_path(int v, int w) const {
-	return to_string(v) + trace(v, w) + "-" + to_string(w) + ", " +
-		(sp_matrix[v][w] == 0 && v != w ? "inf" : to_string(sp_matrix[v][w]));
-}
\ No newline at end of file
+template<typename Graph, typename Stats>
+string ShortestPathSearcher<Graph, Stats>::get_path(int v, int w) const {
+	stats.reset();
+	stats.begin(QueryStats::SEARCH);
+	int d = sp_matrix[v * stride + w];
+	string res;
+	if(d == INF_COST) {
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(v, w);
+	}
+	else {
+		vector<int> path = trace(v, w);
+		stats.begin(QueryStats::FORMATTING);
+		res = PathTracer::format(path, d);
+	}
+	stats.allocate(res.size());
+	stats.end();
+	return res;
+}
+
+// Функция возвращает статистику последней операции.
+template<typename Graph, typename Stats>
+const Stats &ShortestPathSearcher<Graph, Stats>::statistics() const { return stats; }
\ No newline at end of file
@@ -2,27 +2,171 @@
 #define _SHORTEST_PATH_SEARCHER_
 
 #include "main_header.hpp"
+#include "ThreadPool.hpp"
+#include "DaryHeap.hpp"
+#include "GraphObserver.hpp"
+#include "PathTracer.hpp"
+#include "DagSearcher.hpp"
+#include "SearchControl.hpp"
+#include "SearchStats.hpp"
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 /*
  * ~~~~ Краткое описание класса:
  * Модульный класс, использующийся для поиска картчайших путей в графе Graph.
+ * ~~~~ Примечания:
+ * Кратчайшие пути между всеми парами вершин вычисляются в конструкторе блочным
+ * алгоритмом Флойда (см. floyd()). Для ациклического ориентированного графа
+ * вместо него каждая строка вычисляется проходом в топологическом порядке
+ * (см. DagSearcher) - всего O(V * (V + E)). Матрицы хранятся в плоских векторах с длиной
+ * строки stride, кратной размеру блока; отсутствие пути обозначается INF_COST.
+ * Внутренний цикл алгоритма не содержит ветвлений и использует инструкции
+ * AVX-512 или AVX2, если они разрешены при компиляции (например, -mavx2 или
+ * -march=native), иначе - SSE2 либо скалярную версию.
+ * Экземпляр подписывается на изменения графа (см. GraphObserver) и поддерживает
+ * матрицы актуальными: добавление дуги обрабатывается за O(V^2), удаление -
+ * пересчетом поиском Дейкстры только тех строк, кратчайшие пути которых проходили
+ * через удаленную дугу. Граф должен существовать дольше экземпляра.
+ * Построение матриц в конструкторе можно прервать (см. SearchControl): алгоритм
+ * Флойда проверяет остановку перед каждым блоком, проходы по строкам - перед
+ * каждой строкой. Матрицы прерванного построения содержат стоимости
+ * существующих путей, но не обязательно кратчайших.
+ * Stats - политика статистики (см. NoStats, CountingStats): статистику сбрасывают
+ * построение матриц в конструкторе, обработка изменения графа и запросы
+ * distance(), path() и get_path(). Построение учитывает дуги, просмотренные при
+ * составлении матрицы смежности (этап подготовки), и раскрытые вершины этапа
+ * поиска: опорные вершины алгоритма Флойда, вычисленные и обновленные строки,
+ * вершины поисков Дейкстры. Запрос - чтение матрицы (поиск), восстановление пути
+ * и форматирование строки. Статистика хранится в экземпляре, поэтому с
+ * CountingStats запросы не выполняются одновременно из нескольких потоков.
 */
-template<typename Graph>
-class ShortestPathSearcher {
+template<typename Graph, typename Stats = NoStats>
+class ShortestPathSearcher : public GraphObserver {
 private:
-	int v_cnt;
-	vector<vector<int>> sp_tracer, sp_matrix;
+	/* Размер блока (стороны квадратной плитки) блочного алгоритма Флойда. */
+	static const int BLOCK = 64;
+
+	int v_cnt, stride;
+	/*
+	 * sp_matrix[i * stride + j] - стоимость кратчайшего пути из i в j;
+	 * sp_tracer[i * stride + j] - промежуточная вершина k, разбивающая этот путь на
+	 * пути i-k и k-j, либо -1, если путь состоит из одного ребра (или не существует).
+	*/
+	vector<int> sp_tracer, sp_matrix;
+
+	const Graph &G;
+	int threads;
+	/* Признак наличия в графе дуг отрицательной стоимости. */
+	bool negative;
+
+	/* Статистика последней операции (построения, обработки изменения или запроса). */
+	mutable Stats stats;
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Ядро алгоритма: релаксация строки d (с соответствующей строкой трассировки tr)
+	 * через вершину k: d[j] = min(d[j], dik + dk[j]) для j = 0, ..., n - 1.
+	 * ~~~~ Примечания:
+	 * Не содержит ветвлений: элементы dk, равные INF_COST, исключаются маской.
+	*/
+	static inline void relax_row(int *d, int *tr, const int *dk, int dik, int k, int n);
+
+	/*
+	 * Вспомогательная функция релаксации плитки (ci, cj) через вершины блока kb.
+	 * Используется на всех трех фазах блочного алгоритма.
+	*/
+	void relax_tile(int ci, int cj, int kb);
 
 	/*
-	 * Вспомогательная функция, возвращающая путь из промежуточных вершин полного
-	 * пути от вершины v до вершины w в строке вида -k1-k2...-kn, где k1, ..., kn -
-	 * вершины графа G в кратчайшем пути v-k1-k2-...-kn-w. Используется функцией
-	 * get_path().
+	 * ~~~~ Описание функции:
+	 * Блочный алгоритм Флойда. Для каждого блока kb выполняются три фазы:
+	 * 1) релаксация диагональной плитки (kb, kb);
+	 * 2) релаксация плиток строки kb и столбца kb (параллельно);
+	 * 3) релаксация всех остальных плиток (параллельно).
+	 * Перед каждым блоком проверяется control (nullptr - без ограничений).
 	*/
-	string trace(int v, int w) const;
+	void floyd(int threads, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция вычисления всех строк матриц проходами в
+	 * топологическом порядке ациклического графа dag (параллельно). Перед каждой
+	 * строкой проверяется control; невычисленные строки остаются матрицей смежности.
+	*/
+	void sweep_rows(const DagSearcher<Graph> &dag, SearchControl *control);
+
+	/*
+	 * Вспомогательная функция построения матриц для текущего состояния графа G
+	 * (control - см. floyd()).
+	*/
+	void build(SearchControl *control = nullptr);
+
+	/*
+	 * Вспомогательная функция обновления матриц после добавления (удешевления)
+	 * дуги (a, b) стоимостью c за O(V^2).
+	*/
+	void insert_arc(int a, int b, int c);
+
+	/* Вспомогательная функция пересчета строк rows поиском Дейкстры в текущем графе G. */
+	void recompute_rows(const vector<int> &rows);
+
+	/* Вспомогательная функция обработки изменения дуги (см. edge_changed()) без сброса статистики. */
+	void update(int v, int w, int old_c, int new_c);
+
+	/* Вспомогательная функция восстановления существующего пути от v до w (см. path()). */
+	vector<int> trace(int v, int w) const;
 public:
-	/* Конструктор. */
-	ShortestPathSearcher(const Graph &G);
+	/*
+	 * Конструктор.
+	 * ~~~~ Описание параметров:
+	 * G - граф; threads - количество потоков для вычисления матрицы (0 - по
+	 * количеству аппаратных потоков); control - управление построением матриц
+	 * (nullptr - без ограничений; используется только в конструкторе).
+	*/
+	ShortestPathSearcher(const Graph &G, int threads = 0, SearchControl *control = nullptr);
+
+	/* Деструктор. Отписывается от изменений графа. */
+	~ShortestPathSearcher();
+
+	/* Копирование запрещено: экземпляр зарегистрирован в графе по адресу. */
+	ShortestPathSearcher(const ShortestPathSearcher &) = delete;
+	ShortestPathSearcher &operator=(const ShortestPathSearcher &) = delete;
+
+	/*
+	 * Функция обработки изменения дуги (v, w) графа (см. GraphObserver). Вызывается
+	 * графом; вызывать напрямую не требуется.
+	*/
+	void edge_changed(int v, int w, int old_c, int new_c) override;
+
+	/*
+	 * Функция возвращает стоимость кратчайшего пути от вершины v до вершины w
+	 * либо INF_COST, если пути не существует.
+	*/
+	inline int distance(int v, int w) const;
+
+	/*
+	 * Функция возвращает вершину, предшествующую вершине w на кратчайшем пути от
+	 * вершины v, либо -1, если пути не существует или v == w.
+	*/
+	int predecessor(int v, int w) const;
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция записывает кратчайший путь от вершины v до вершины w (номера вершин
+	 * v, k1, ..., kn, w) в буфер buf емкостью capacity (см. PathTracer).
+	 * ~~~~ Примечания:
+	 * Возвращает количество вершин пути, 0, если пути не существует, либо -1, если
+	 * путь не помещается в буфер. Память не выделяет.
+	*/
+	int path(int v, int w, int *buf, int capacity) const;
+
+	/*
+	 * Функция возвращает кратчайший путь от вершины v до вершины w в виде вектора
+	 * номеров вершин v, k1, ..., kn, w (пустой вектор, если пути не существует).
+	*/
+	vector<int> path(int v, int w) const;
 
 	/*
 	 * Функция возвращает строку с полным кратчайшим путем от вершины v до вершины
@@ -31,6 +175,12 @@ public:
 	 * пути, а P - стоимость полного кратчайшего пути.
 	*/
 	string get_path(int v, int w) const;
+
+	/*
+	 * Функция возвращает статистику последней операции: построения матриц,
+	 * обработки изменения графа или запроса.
+	*/
+	inline const Stats &statistics() const;
 };
 
 #endif // _SHORTEST_PATH_SEARCHER_
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "SnapshotGraph.hpp"
+
+// Конструктор. Строит первый снимок.
+template<typename Graph>
+SnapshotGraph::SnapshotGraph(const Graph &G) :
+	v_cnt(G.V()), _directed(G.directed()), current(make_shared<const CsrGraph>(G)) { }
+
+// Функция возвращает количество вершин в графе.
+int SnapshotGraph::V() const { return v_cnt; }
+
+// Функция проверки графа на ориентированность.
+bool SnapshotGraph::directed() const { return _directed; }
+
+// Функция возвращает текущий снимок. Указатель читается атомарно, поэтому
+// одновременная публикация нового снимка не повреждает его.
+shared_ptr<const CsrGraph> SnapshotGraph::snapshot() const { return atomic_load(&current); }
+
+// Функция возвращает номер версии текущего снимка.
+unsigned long long SnapshotGraph::version() const { return snapshot()->version(); }
+
+// Функция добавления дуги в следующий снимок. Дуги с некорректными номерами вершин
+// и нулевой стоимостью пропускаются (как в DenseGraph::insert()).
+void SnapshotGraph::insert(int v, int w, int c) {
+	if(v < 0 || w < 0 || v >= v_cnt || w >= v_cnt || c == 0)
+		return;
+	lock_guard<mutex> lock(writer);
+	pending.push_back(Edge(v, w, c));
+	if(!_directed)
+		pending.push_back(Edge(w, v, c));
+}
+
+// Функция удаления дуги из следующего снимка.
+void SnapshotGraph::remove(int v, int w) {
+	if(v < 0 || w < 0 || v >= v_cnt || w >= v_cnt)
+		return;
+	lock_guard<mutex> lock(writer);
+	pending.push_back(Edge(v, w, 0));
+	if(!_directed)
+		pending.push_back(Edge(w, v, 0));
+}
+
+// Функция возвращает количество накопленных изменений.
+int SnapshotGraph::uncommitted() {
+	lock_guard<mutex> lock(writer);
+	return pending.size();
+}
+
+// Функция публикации следующего снимка. Сначала по изменениям вычисляется итоговое
+// состояние каждой затронутой дуги (стоимость либо 0, если дуги нет): добавление
+// изменяет только отсутствующую дугу, удаление - любую. Затем дуги текущего
+// снимка, не затронутые изменениями, и затронутые дуги с итоговой стоимостью
+// копируются в новый снимок. Текущий снимок читается без атомарной операции: его
+// заменяет только commit(), а commit() выполняется под блокировкой писателя.
+unsigned long long SnapshotGraph::commit() {
+	lock_guard<mutex> lock(writer);
+	shared_ptr<const CsrGraph> old = current;
+	const CsrGraph &G = *old;
+	if(pending.empty())
+		return G.version();
+
+	unordered_map<long long, int> state;
+	for(auto &e : pending) {
+		long long key = (long long)e.v * v_cnt + e.w;
+		auto it = state.find(key);
+		int c = (it != state.end() ? it->second : G.edge(e.v, e.w));
+		if(e.c == 0 || c == 0)
+			state[key] = e.c;
+	}
+	pending.clear();
+
+	vector<Edge> arcs;
+	arcs.reserve(G.E() + state.size());
+	for(int v = 0; v < v_cnt; ++v)
+		for(int i = G.first(v); i < G.last(v); ++i)
+			if(state.find((long long)v * v_cnt + G.target(i)) == state.end())
+				arcs.push_back(Edge(v, G.target(i), G.cost(i)));
+	for(auto &s : state)
+		if(s.second != 0)
+			arcs.push_back(Edge(s.first / v_cnt, s.first % v_cnt, s.second));
+
+	auto next = make_shared<const CsrGraph>(v_cnt, arcs, _directed, G.version() + 1);
+	atomic_store(&current, next);
+	return next->version();
+}
@@ -0,0 +1,91 @@
+#ifndef _SNAPSHOT_GRAPH_
+#define _SNAPSHOT_GRAPH_
+
+#include "main_header.hpp"
+#include "CsrGraph.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Изменяемый граф с изоляцией снимков: поиски выполняются по неизменяемым
+ * снимкам графа (CsrGraph), а изменения накапливаются и публикуются пакетом в
+ * виде нового снимка, не останавливая выполняющиеся поиски.
+ * ~~~~ Примечания:
+ * Читатель получает текущий снимок методом snapshot() и удерживает его, пока
+ * владеет возвращенным указателем; снимок не изменяется, поэтому поиск по нему
+ * не требует блокировок. Писатель добавляет и удаляет дуги методами insert() и
+ * remove() (изменения видны только после публикации), затем метод commit()
+ * строит следующий снимок из текущего и накопленных изменений и атомарно
+ * заменяет им текущий. Читатели, получившие снимок раньше, продолжают работать
+ * со старой версией; снимок освобождается, когда его перестает удерживать
+ * последний читатель (подсчет ссылок shared_ptr). Получение снимка не ожидает
+ * писателя: построение нового снимка выполняется без блокировки читателей.
+ * Каждый опубликованный снимок получает следующий номер версии (см.
+ * CsrGraph::version()), поэтому номер снимка можно использовать как версию
+ * графа в ResultCache. Методы писателя потокобезопасны (выполняются под общей
+ * блокировкой); количество вершин постоянно.
+*/
+class SnapshotGraph {
+private:
+	int v_cnt;
+	bool _directed;
+	/* Текущий опубликованный снимок; читается и заменяется атомарно. */
+	shared_ptr<const CsrGraph> current;
+	/*
+	 * Накопленные изменения в порядке поступления: дуга (v, w) стоимостью c
+	 * добавляется, дуга с c == 0 удаляется.
+	*/
+	vector<Edge> pending;
+	mutex writer;
+public:
+	/*
+	 * Конструктор. Первый снимок - CSR-представление графа G любого типа проекта
+	 * с номером версии G.version().
+	*/
+	template<typename Graph>
+	explicit SnapshotGraph(const Graph &G);
+
+	/* Функция возвращает количество вершин в графе. */
+	inline int V() const;
+
+	/* Функция проверки графа на ориентированность. */
+	inline bool directed() const;
+
+	/*
+	 * Функция возвращает текущий снимок графа. Снимок остается действительным и
+	 * неизменным, пока существует хотя бы одна копия указателя.
+	*/
+	shared_ptr<const CsrGraph> snapshot() const;
+
+	/* Функция возвращает номер версии текущего снимка. */
+	unsigned long long version() const;
+
+	/*
+	 * Функция добавления в следующий снимок дуги из вершины v в вершину w стоимостью
+	 * c. Как и в DenseGraph, существующая дуга не изменяется; в неориентированном
+	 * графе добавляется также дуга из w в v.
+	*/
+	void insert(int v, int w, int c);
+
+	/*
+	 * Функция удаления из следующего снимка дуги из вершины v в вершину w. В
+	 * неориентированном графе удаляется также дуга из w в v.
+	*/
+	void remove(int v, int w);
+
+	/* Функция возвращает количество накопленных и еще не опубликованных изменений. */
+	int uncommitted();
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция построения и публикации следующего снимка по текущему снимку и
+	 * накопленным изменениям. Возвращает номер версии текущего снимка после
+	 * публикации.
+	 * ~~~~ Примечания:
+	 * Изменения применяются в порядке поступления. Если изменений нет, снимок не
+	 * строится и версия не изменяется. Построение выполняется за O(E + B)
+	 * (B - количество изменений) плюс сортировка списков смежности.
+	*/
+	unsigned long long commit();
+};
+
+#endif // _SNAPSHOT_GRAPH_
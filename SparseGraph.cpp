@@ -27,7 +27,7 @@ int SparseGraph::path_exists(int from_v, int to_v) const {
 // ~~~~ Примечания:
 // Параметр _directed имеет значение по умолчанию, равное true.
 SparseGraph::SparseGraph(int V, bool _directed) :
-	adjLists(V, nullptr), v_cnt(V), e_cnt(0), _directed(_directed) { }
+	adjLists(V, nullptr), v_cnt(V), e_cnt(0), _directed(_directed), _version(0) { }
 
 // Деструктор. Освобождает память, выделенную под списки смежности.
 SparseGraph::~SparseGraph() {
@@ -75,6 +75,8 @@ void SparseGraph::insert(int v, int w, int c) {
 	if(adjLists[v] == nullptr){
 		adjLists[v] = new node(w, c);
 		++e_cnt;
+		++_version;
+		observers.notify(v, w, 0, c);
 		// Если граф ненаправленный и ребра из w в v не существует, добавляем его.
 		if(!_directed && !path_exists(w, v))
 			insert(w, v, c);
@@ -90,6 +92,8 @@ void SparseGraph::insert(int v, int w, int c) {
 		if(temp->v != w) {
 			temp->next = new node(w, c);
 			++e_cnt;
+			++_version;
+			observers.notify(v, w, 0, c);
 			// Если граф ненаправленный и ребра из w в v не существует, добавляем его.
 			if(!_directed && !path_exists(w, v))
 				insert(w, v, c);
@@ -114,9 +118,12 @@ void SparseGraph::remove(int v, int w) {
 
 	link temp = adjLists[v];
 	if(adjLists[v]->v == w) {
+		int c = temp->c;
 		adjLists[v] = adjLists[v]->next;
 		delete temp;
 		--e_cnt;
+		++_version;
+		observers.notify(v, w, c, 0);
 		// Если граф ненаправленный и ребро из w в v существует, удаляем его.
 		if(!_directed && path_exists(w, v))
 			remove(w, v);
@@ -124,8 +131,11 @@ void SparseGraph::remove(int v, int w) {
 	}
 	while(temp->next != nullptr) {
 		if(temp->next->v == w) {
+			int c = temp->next->c;
 			delete_next(temp);
 			--e_cnt;
+			++_version;
+			observers.notify(v, w, c, 0);
 			// Если граф ненаправленный и ребро из w в v существует, удаляем его.
 			if(!_directed && edge(w, v))
 				remove(w, v);
@@ -135,6 +145,14 @@ void SparseGraph::remove(int v, int w) {
 	}
 }
 
+// Функции подписки и отписки наблюдателя o на изменения графа.
+void SparseGraph::subscribe(GraphObserver *o) const { observers.subscribe(o); }
+
+void SparseGraph::unsubscribe(GraphObserver *o) const { observers.unsubscribe(o); }
+
+// Функция возвращает номер версии графа.
+unsigned long long SparseGraph::version() const { return _version; }
+
 // Статический метод, идентифицирует ребра, представленные в строке data,
 // создает их и сохраняет в векторе edges.
 // ~~~~ Примечания:
@@ -176,7 +194,7 @@ void SparseGraph::scan_edges(vector<Edge> &edges, string data) {
 	}
 }
 
-/* Выражения (1), (2), (3) и (4) ниже описывают класс внутреннего итератора для
+/* Выражения (1), (2), (3), (4) и (5) ниже описывают класс внутреннего итератора для
 класса SparseGraph: */
 
 // Конструктор. G - граф, к которому применяется итератор, v - номер вершины,
@@ -208,4 +226,7 @@ int SparseGraph::adjIterator::next() {	// (3)
 
 // Метод проверки текущего состояния итератора. Если все смежные с v вершины
 // пройдены, будет возвращено true, иначе false.
-bool SparseGraph::adjIterator::end() { return curr == nullptr; } // (4)
\ No newline at end of file
+bool SparseGraph::adjIterator::end() { return curr == nullptr; } // (4)
+
+// Метод возвращает стоимость ребра из вершины v в текущую смежную вершину.
+int SparseGraph::adjIterator::cost() const { return curr->c; }	// (5)
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define _SPARSE_GRAPH_
 
 #include "main_header.hpp"
+#include "GraphObserver.hpp"
 
 /*
  * ~~~~ Краткое описание класса:
@@ -29,6 +30,10 @@ private:
 	vector<link> adjLists;
 	int v_cnt, e_cnt;
 	bool _directed;
+	/* Наблюдатели изменений графа (см. subscribe()). */
+	GraphObservers observers;
+	/* Номер версии графа (см. version()). */
+	unsigned long long _version;
 
 	/* Вспомогательная функция удаления узла l->next из списка, в котором он находится. */
 	inline void delete_next(link l);
@@ -105,6 +110,26 @@ public:
 	*/
 	void remove(int v, int w);
 
+	/*
+	 * ~~~~ Описание функции:
+	 * Функции подписки и отписки наблюдателя o на изменения графа (см. GraphObserver).
+	 * ~~~~ Примечания:
+	 * После подписки каждое добавление и удаление дуги методами insert() и remove()
+	 * сообщается наблюдателю. Наблюдатель должен отписаться до своего уничтожения.
+	*/
+	inline void subscribe(GraphObserver *o) const;
+	inline void unsubscribe(GraphObserver *o) const;
+
+	/*
+	 * ~~~~ Описание функции:
+	 * Функция возвращает номер версии графа.
+	 * ~~~~ Примечания:
+	 * Номер увеличивается при каждом добавлении и удалении дуги методами insert() и
+	 * remove(), поэтому равенство номеров означает неизменность графа. Используется
+	 * для проверки актуальности сохраненных результатов поиска (см. ResultCache).
+	*/
+	inline unsigned long long version() const;
+
 	/*
 	 * ~~~~ Описание метода:
 	 * Статический метод, идентифицирующий ребра, представленные в строке data,
@@ -160,6 +185,16 @@ public:
 		 * пройдены, будет возвращено true, иначе false.
 		*/
 		bool end();
+
+		/*
+		 * ~~~~ Описание метода:
+		 * Метод возвращает стоимость ребра, ведущего в текущую смежную вершину
+		 * (последнюю возвращенную методами begin() или next()).
+		 * ~~~~ Примечания:
+		 * Позволяет избежать повторного поиска ребра методом edge() при обходе
+		 * смежных вершин. Вызов допустим только пока end() возвращает false.
+		*/
+		int cost() const;
 	};
 };
 
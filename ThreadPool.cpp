@@ -0,0 +1,70 @@
+#include "ThreadPool.hpp"
+
+// Основная функция рабочего потока. Поток ожидает появления задачи в очереди
+// (или сигнала остановки), выполняет ее и уведомляет ожидающих в wait(), если
+// невыполненных задач не осталось.
+void ThreadPool::worker_loop() {
+	while(true) {
+		function<void()> task;
+		{
+			unique_lock<mutex> lock(m);
+			task_ready.wait(lock, [this] { return stop || !tasks.empty(); });
+			if(stop && tasks.empty())
+				return;
+			task = move(tasks.front());
+			tasks.pop();
+		}
+
+		task();
+
+		lock_guard<mutex> lock(m);
+		if(--pending == 0)
+			all_done.notify_all();
+	}
+}
+
+// Конструктор. Если threads <= 0, количество потоков определяется по количеству
+// аппаратных потоков (но не меньше одного).
+ThreadPool::ThreadPool(int threads) : pending(0), stop(false) {
+	if(threads <= 0)
+		threads = max(1u, thread::hardware_concurrency());
+	for(int t = 0; t < threads; ++t)
+		workers.emplace_back(&ThreadPool::worker_loop, this);
+}
+
+// Деструктор. Дожидается завершения поставленных задач и останавливает потоки.
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<mutex> lock(m);
+		stop = true;
+	}
+	task_ready.notify_all();
+	for(auto &worker : workers)
+		worker.join();
+}
+
+// Функция возвращает количество потоков в пуле.
+int ThreadPool::size() const { return workers.size(); }
+
+// Функция постановки задачи task в очередь.
+void ThreadPool::submit(function<void()> task) {
+	{
+		lock_guard<mutex> lock(m);
+		tasks.push(move(task));
+		++pending;
+	}
+	task_ready.notify_one();
+}
+
+// Функция ожидания завершения всех поставленных в очередь задач.
+void ThreadPool::wait() {
+	unique_lock<mutex> lock(m);
+	all_done.wait(lock, [this] { return pending == 0; });
+}
+
+// Функция выполнения body(t) для каждого номера потока t и ожидания завершения.
+void ThreadPool::run(const function<void(int)> &body) {
+	for(int t = 0; t < size(); ++t)
+		submit([&body, t] { body(t); });
+	wait();
+}
\ No newline at end of file
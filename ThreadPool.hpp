@@ -0,0 +1,55 @@
+#ifndef _THREAD_POOL_
+#define _THREAD_POOL_
+
+#include "main_header.hpp"
+
+/*
+ * ~~~~ Краткое описание класса:
+ * Пул потоков фиксированного размера для параллельных алгоритмов на графах.
+ * ~~~~ Примечания:
+ * Потоки создаются в конструкторе и живут до уничтожения пула. Задачи ставятся в
+ * общую очередь методом submit(), метод wait() ожидает завершения всех поставленных
+ * задач. Метод run() - основной способ использования в алгоритмах: он выполняет
+ * функцию body(t) для каждого номера потока t = 0, ..., size() - 1 и дожидается
+ * их завершения; номер t удобно использовать как индекс потоковых буферов.
+ * Для сборки требуется флаг -pthread.
+*/
+class ThreadPool {
+private:
+	vector<thread> workers;
+	queue<function<void()>> tasks;
+	mutex m;
+	condition_variable task_ready, all_done;
+	/* Количество задач, поставленных в очередь или выполняющихся в данный момент. */
+	int pending;
+	bool stop;
+
+	/* Основная функция рабочего потока: извлекает и выполняет задачи из очереди. */
+	void worker_loop();
+public:
+	/*
+	 * Конструктор. threads - количество потоков; если threads <= 0, используется
+	 * количество аппаратных потоков (std::thread::hardware_concurrency()).
+	*/
+	ThreadPool(int threads = 0);
+
+	/* Деструктор. Дожидается завершения поставленных задач и останавливает потоки. */
+	~ThreadPool();
+
+	/* Функция возвращает количество потоков в пуле. */
+	inline int size() const;
+
+	/* Функция постановки задачи task в очередь. */
+	void submit(function<void()> task);
+
+	/* Функция ожидания завершения всех поставленных в очередь задач. */
+	void wait();
+
+	/*
+	 * Функция выполнения body(t) для t = 0, ..., size() - 1 в потоках пула.
+	 * Возвращает управление после завершения всех вызовов.
+	*/
+	void run(const function<void(int)> &body);
+};
+
+#endif // _THREAD_POOL_
\ No newline at end of file
@@ -0,0 +1,420 @@
+// Набор микро- и макротестов производительности на синтетических графах (см.
+// GraphGenerator): для каждого типа графа (Эрдёш-Реньи, решетка, R-MAT,
+// многослойный ациклический граф, цепочка) и каждого представления (DenseGraph,
+// SparseGraph, CsrGraph) измеряются чтение графа из текста, построение, перебор
+// смежных вершин, поиск путей DeepSearcher, поиск в ширину, кратчайшие пути между
+// всеми парами ShortestPathSearcher, запросы DijkstraSearcher и BucketSearcher и
+// пакеты запросов BatchSearcher. Результаты записываются в формате JSON (минимум, процентили,
+// максимум и среднее по повторам, для запросов - также пропускная способность в
+// запросах в секунду) и могут сравниваться с сохраненными ранее результатами.
+//
+// Вызов: benchmark [-s small|medium|large] [-n V] [-r repeats] [-t threads] [-o file]
+//                  [-b baseline] [--threshold percent] [--seed seed] [--dfs-ms ms]
+// -s - масштаб: количество вершин 1024, 16384 или 262144 (по умолчанию small);
+// -n - произвольное количество вершин (вместо -s);
+// -r - количество повторов каждого измерения (по умолчанию 5);
+// -t - количество потоков (0 - количество аппаратных потоков, по умолчанию);
+// -o - файл результатов (по умолчанию стандартный вывод);
+// -b - файл результатов предыдущего запуска для сравнения медиан: измерения,
+// медиана которых выросла более чем на threshold процентов (по умолчанию 10),
+// выводятся как регрессии, и программа завершается с кодом 2;
+// --seed - начальное значение генераторов графов (по умолчанию 1);
+// --dfs-ms - ограничение времени одного поиска путей в миллисекундах (по умолчанию 1000).
+//
+// ~~~~ Примечания:
+// DenseGraph строится только для графов до DENSE_MAX вершин (матрица смежности
+// занимает V^2 чисел), ShortestPathSearcher - только до APSP_MAX вершин (O(V^3)) и
+// только для DenseGraph и SparseGraph (требуется подписка на изменения графа).
+// Поиск в ширину выполняет MultiSourceBFS из 64 вершин за один проход; поиск путей -
+// DeepSearcher::lazy_paths() из вершины 0 в достижимую из нее вершину с наибольшим
+// номером (без рекурсии, поэтому допустимы длинные цепочки) с индексом
+// достижимости и ограничением количества путей PATH_LIMIT и времени (см.
+// SearchControl). Количество перебираемых простых путей может расти
+// экспоненциально, поэтому поиск, остановленный по времени, отмечается в
+// результатах состоянием "deadline exceeded".
+// Запросы BucketSearcher (bucket) измеряются только для CsrGraph - на тех же
+// QUERIES случайных парах вершин, что и DijkstraSearcher (dijkstra), поэтому оба
+// поиска работают с одним представлением и их пропускная способность сравнима.
+// Пакет (batch) - BATCH_QUERIES запросов из BATCH_SOURCES общих стартовых вершин;
+// он обрабатывается BatchSearcher (batch) и для сравнения - отдельными запросами
+// DijkstraSearcher (batch_single). Пропускная способность (qps) вычисляется по
+// медиане времени.
+
+#include "GraphObserver.cpp"
+#include "SparseGraph.cpp"
+#include "DenseGraph.cpp"
+#include "CsrGraph.cpp"
+#include "ThreadPool.cpp"
+#include "SearchControl.cpp"
+#include "SearchStats.cpp"
+#include "ConcurrentGraphBuilder.cpp"
+#include "PathTracer.cpp"
+#include "ShortestPathSearcher.cpp"
+#include "DeepSearcher.cpp"
+#include "PathGenerator.cpp"
+#include "DaryHeap.cpp"
+#include "DijkstraSearcher.cpp"
+#include "RadixHeap.cpp"
+#include "BucketSearcher.cpp"
+#include "BatchSearcher.cpp"
+#include "MultiSourceBFS.cpp"
+#include "SccDecomposition.cpp"
+#include "DagSearcher.cpp"
+#include "ReachabilityIndex.cpp"
+#include "GraphGenerator.cpp"
+
+#include <chrono>
+#include <cmath>
+#include <map>
+
+using namespace std;
+
+static const int DENSE_MAX = 4096, APSP_MAX = 1024, PATH_LIMIT = 100, BFS_SOURCES = 64,
+	QUERIES = 64, BATCH_QUERIES = 256, BATCH_SOURCES = 16;
+
+/*
+ * ~~~~ Описание структуры:
+ * Результат одного измерения: name - "граф/представление/операция", samples -
+ * время каждого повтора в наносекундах, status - состояние последнего поиска
+ * (для поиска путей, см. SearchControl::name()), queries - количество запросов
+ * в одном повторе (0 - измерение не состоит из запросов).
+*/
+struct result {
+	string name;
+	int V;
+	long long E;
+	vector<double> samples;
+	string status;
+	int queries;
+};
+
+/* Параметры запуска. */
+struct options {
+	int repeats = 5, threads = 0;
+	unsigned long long seed = 1;
+	long long dfs_ms = 1000;
+};
+
+// Функция измерения: выполняет f() repeats раз и возвращает время каждого
+// выполнения в наносекундах.
+static vector<double> measure(int repeats, const function<void()> &f) {
+	vector<double> res;
+	for(int i = 0; i < repeats; ++i) {
+		auto start = chrono::steady_clock::now();
+		f();
+		res.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+	}
+	return res;
+}
+
+// Функция возвращает процентиль q (0 < q <= 1) отсортированной выборки по
+// ближайшему рангу.
+static double percentile(const vector<double> &sorted, double q) {
+	size_t k = (size_t)ceil(q * sorted.size());
+	return sorted[max(k, (size_t)1) - 1];
+}
+
+// Функции построения графов из вектора дуг (дуги добавляются так же, как при
+// чтении из файла; CsrGraph строится ConcurrentGraphBuilder).
+static void build_graph(unique_ptr<DenseGraph> &G, int V, const vector<Edge> &edges, int) {
+	G.reset(new DenseGraph(V, true));
+	for(auto &e : edges)
+		G->insert(e);
+}
+
+static void build_graph(unique_ptr<SparseGraph> &G, int V, const vector<Edge> &edges, int) {
+	G.reset(new SparseGraph(V, true));
+	for(auto &e : edges)
+		G->insert(e);
+}
+
+static void build_graph(unique_ptr<CsrGraph> &G, int V, const vector<Edge> &edges, int threads) {
+	ConcurrentGraphBuilder builder(V, true);
+	for(auto &e : edges)
+		builder.insert(0, e);
+	G.reset(new CsrGraph(builder.build(threads)));
+}
+
+// Функции чтения графов из текста: матрицы смежности для DenseGraph, списка
+// "v-w, c;" для SparseGraph и CsrGraph.
+static void load_graph(unique_ptr<DenseGraph> &G, int V, const string &matrix, const string &,
+		int threads)
+{
+	vector<Edge> edges;
+	DenseGraph::scan_edges(edges, matrix);
+	build_graph(G, V, edges, threads);
+}
+
+template<typename Graph>
+static void load_graph(unique_ptr<Graph> &G, int V, const string &, const string &list,
+		int threads)
+{
+	vector<Edge> edges;
+	SparseGraph::scan_edges(edges, list);
+	build_graph(G, V, edges, threads);
+}
+
+// Функция выполнения всех измерений для представления Graph графа gen с V
+// вершинами и дугами edges; list и matrix - текстовые представления графа.
+template<typename Graph>
+static void run_suite(vector<result> &results, const string &gen, const string &repr, int V,
+		const vector<Edge> &edges, const string &list, const string &matrix, const options &opt)
+{
+	string prefix = gen + "/" + repr + "/";
+	unique_ptr<Graph> G;
+	auto add = [&](const string &op, vector<double> samples, string status = "", int queries = 0) {
+		results.push_back({prefix + op, V, G->E(), move(samples), move(status), queries});
+		cerr << results.back().name << ": ";
+		vector<double> s = results.back().samples;
+		sort(s.begin(), s.end());
+		cerr << percentile(s, 0.5) / 1e6 << " ms";
+		if(queries)
+			cerr << " (" << queries * 1e9 / max(percentile(s, 0.5), 1.0) << " qps)";
+		cerr << endl;
+	};
+
+	build_graph(G, V, edges, opt.threads);
+	add("load", measure(opt.repeats, [&]() {
+		unique_ptr<Graph> H;
+		load_graph(H, V, matrix, list, opt.threads);
+	}));
+	add("build", measure(opt.repeats, [&]() {
+		unique_ptr<Graph> H;
+		build_graph(H, V, edges, opt.threads);
+	}));
+
+	volatile long long sink = 0;
+	add("iterate", measure(opt.repeats, [&]() {
+		long long sum = 0;
+		for(int v = 0; v < V; ++v) {
+			typename Graph::adjIterator A(*G, v);
+			for(A.begin(); !A.end(); A.next())
+				sum += A.cost();
+		}
+		sink = sink + sum;
+	}));
+
+	ReachabilityIndex<Graph> index(*G);
+	DeepSearcher<Graph> DS(*G, &index);
+	SearchControl control;
+	control.set_limit(PATH_LIMIT);
+	int target = V - 1;
+	while(target > 0 && !index.reachable(0, target))
+		--target;
+	vector<double> samples = measure(opt.repeats, [&]() {
+		control.reset();
+		control.set_timeout(opt.dfs_ms);
+		auto paths = DS.lazy_paths(0, target, &control);
+		vector<int> p;
+		int c;
+		while(paths.next(p, c));
+	});
+	add("dfs", samples, SearchControl::name(control.result()));
+
+	MultiSourceBFS<Graph> BFS(*G);
+	vector<int> sources;
+	for(int v = 0; v < min(V, BFS_SOURCES); ++v)
+		sources.push_back(v);
+	add("bfs", measure(opt.repeats, [&]() { BFS.run(sources, true); }));
+
+	if(V <= APSP_MAX)
+		add("apsp", measure(opt.repeats, [&]() { ShortestPathSearcher<Graph> SP(*G, opt.threads); }));
+
+	mt19937_64 rng(opt.seed);
+	vector<pair<int, int>> queries;
+	for(int i = 0; i < QUERIES; ++i)
+		queries.push_back({(int)(rng() % V), (int)(rng() % V)});
+	DijkstraSearcher<Graph> DJ(*G);
+	add("dijkstra", measure(opt.repeats, [&]() {
+		for(auto &q : queries)
+			sink = sink + DJ.distance(q.first, q.second);
+	}), "", QUERIES);
+	if(is_same<Graph, CsrGraph>::value) {
+		BucketSearcher<Graph> BK(*G);
+		add("bucket", measure(opt.repeats, [&]() {
+			for(auto &q : queries)
+				sink = sink + BK.distance(q.first, q.second);
+		}), "", QUERIES);
+	}
+
+	vector<int> roots;
+	for(int i = 0; i < BATCH_SOURCES; ++i)
+		roots.push_back(rng() % V);
+	vector<pair<int, int>> batch;
+	for(int i = 0; i < BATCH_QUERIES; ++i)
+		batch.push_back({roots[i % BATCH_SOURCES], (int)(rng() % V)});
+	BatchSearcher<Graph> BS(*G, opt.threads);
+	add("batch", measure(opt.repeats, [&]() {
+		for(int d : BS.distances(batch))
+			sink = sink + d;
+	}), "", BATCH_QUERIES);
+	add("batch_single", measure(opt.repeats, [&]() {
+		for(auto &q : batch)
+			sink = sink + DJ.distance(q.first, q.second);
+	}), "", BATCH_QUERIES);
+}
+
+// Функция записи результатов в формате JSON.
+static void write_json(ostream &out, const string &scale, const options &opt,
+		const vector<result> &results)
+{
+	out << "{\n  \"scale\": \"" << scale << "\",\n  \"repeats\": " << opt.repeats
+		<< ",\n  \"seed\": " << opt.seed << ",\n  \"results\": [";
+	out << fixed;
+	out.precision(0);
+	for(size_t i = 0; i < results.size(); ++i) {
+		const result &r = results[i];
+		vector<double> s = r.samples;
+		sort(s.begin(), s.end());
+		double mean = 0;
+		for(double x : s)
+			mean += x / s.size();
+		out << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name << "\", \"V\": " << r.V
+			<< ", \"E\": " << r.E << ", \"samples\": " << s.size()
+			<< ", \"min_ns\": " << s.front() << ", \"p50_ns\": " << percentile(s, 0.5)
+			<< ", \"p90_ns\": " << percentile(s, 0.9) << ", \"p99_ns\": " << percentile(s, 0.99)
+			<< ", \"max_ns\": " << s.back() << ", \"mean_ns\": " << mean;
+		if(r.queries)
+			out << ", \"qps\": " << r.queries * 1e9 / max(percentile(s, 0.5), 1.0);
+		if(!r.status.empty())
+			out << ", \"status\": \"" << r.status << "\"";
+		out << "}";
+	}
+	out << "\n  ]\n}\n";
+}
+
+// Функция сравнения медиан с файлом baseline. Возвращает количество регрессий
+// либо -1, если файл не удалось прочитать.
+static int compare(const string &baseline, const vector<result> &results, double threshold) {
+	ifstream fin(baseline);
+	if(!fin.is_open())
+		return -1;
+	stringstream ss;
+	ss << fin.rdbuf();
+	string data = ss.str();
+
+	map<string, double> base;
+	regex entry("\"name\": \"([^\"]+)\"[^}]*\"p50_ns\": ([0-9.]+)");
+	for(sregex_iterator it(data.begin(), data.end(), entry), end; it != end; ++it)
+		base[(*it)[1]] = stod((*it)[2]);
+
+	int regressions = 0;
+	for(auto &r : results) {
+		auto it = base.find(r.name);
+		if(it == base.end())
+			continue;
+		vector<double> s = r.samples;
+		sort(s.begin(), s.end());
+		double curr = percentile(s, 0.5), change = (curr / max(it->second, 1.0) - 1) * 100;
+		bool regressed = change > threshold;
+		regressions += regressed;
+		cerr << (regressed ? "REGRESSION " : "           ") << r.name << ": "
+			<< it->second / 1e6 << " ms -> " << curr / 1e6 << " ms ("
+			<< (change >= 0 ? "+" : "") << change << "%)" << endl;
+	}
+	return regressions;
+}
+
+int main(int argc, char const *argv[]) {
+	options opt;
+	string scale = "small", output, baseline;
+	int V = 1024;
+	double threshold = 10;
+	for(int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if(arg == "-s" && i + 1 < argc) {
+			scale = argv[++i];
+			if(scale == "small")
+				V = 1024;
+			else if(scale == "medium")
+				V = 16384;
+			else if(scale == "large")
+				V = 262144;
+			else {
+				cerr << "Wrong scale: " << scale << endl;
+				return 1;
+			}
+		}
+		else if(arg == "-n" && i + 1 < argc) {
+			V = atoi(argv[++i]);
+			scale = "custom";
+		}
+		else if(arg == "-r" && i + 1 < argc)
+			opt.repeats = max(atoi(argv[++i]), 1);
+		else if(arg == "-t" && i + 1 < argc)
+			opt.threads = atoi(argv[++i]);
+		else if(arg == "-o" && i + 1 < argc)
+			output = argv[++i];
+		else if(arg == "-b" && i + 1 < argc)
+			baseline = argv[++i];
+		else if(arg == "--threshold" && i + 1 < argc)
+			threshold = atof(argv[++i]);
+		else if(arg == "--seed" && i + 1 < argc)
+			opt.seed = strtoull(argv[++i], nullptr, 10);
+		else if(arg == "--dfs-ms" && i + 1 < argc)
+			opt.dfs_ms = atoll(argv[++i]);
+		else {
+			cerr << "Wrong call" << endl;
+			return 1;
+		}
+	}
+	if(V < 4) {
+		cerr << "Wrong call" << endl;
+		return 1;
+	}
+
+	// Параметры генераторов подбираются так, чтобы количество вершин было близко к V
+	// (решетка - квадрат, R-MAT - степень двойки), а средняя степень ER и R-MAT - 8.
+	int side = (int)sqrt((double)V), scale_bits = 0, width = min(V, 32);
+	while((2 << scale_bits) <= V)
+		++scale_bits;
+	struct graph_spec {
+		string name;
+		int V;
+		vector<Edge> edges;
+	};
+	vector<graph_spec> graphs(5);
+	graphs[0].name = "er", graphs[0].V = V;
+	GraphGenerator::erdos_renyi(graphs[0].edges, V, 8LL * V, opt.seed);
+	graphs[1].name = "grid", graphs[1].V = side * side;
+	GraphGenerator::grid(graphs[1].edges, side, side, opt.seed);
+	graphs[2].name = "rmat", graphs[2].V = 1 << scale_bits;
+	GraphGenerator::rmat(graphs[2].edges, scale_bits, 8LL << scale_bits, opt.seed);
+	graphs[3].name = "dag", graphs[3].V = V / width * width;
+	GraphGenerator::layered_dag(graphs[3].edges, V / width, width, 4, opt.seed);
+	graphs[4].name = "chain", graphs[4].V = V;
+	GraphGenerator::chain(graphs[4].edges, V, opt.seed);
+
+	vector<result> results;
+	for(auto &g : graphs) {
+		string list = GraphGenerator::to_list(g.edges), matrix;
+		if(g.V <= DENSE_MAX) {
+			matrix = GraphGenerator::to_matrix(g.edges, g.V);
+			run_suite<DenseGraph>(results, g.name, "dense", g.V, g.edges, list, matrix, opt);
+		}
+		run_suite<SparseGraph>(results, g.name, "sparse", g.V, g.edges, list, matrix, opt);
+		run_suite<CsrGraph>(results, g.name, "csr", g.V, g.edges, list, matrix, opt);
+	}
+
+	if(output.empty())
+		write_json(cout, scale, opt, results);
+	else {
+		ofstream fout(output);
+		if(!fout.is_open()) {
+			cerr << "writing error: " << output << endl;
+			return 1;
+		}
+		write_json(fout, scale, opt, results);
+	}
+
+	if(!baseline.empty()) {
+		int regressions = compare(baseline, results, threshold);
+		if(regressions < 0) {
+			cerr << "reading error: " << baseline << endl;
+			return 1;
+		}
+		if(regressions > 0)
+			return 2;
+	}
+	return 0;
+}
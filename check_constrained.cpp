@@ -0,0 +1,170 @@
+// Проверка ConstrainedPathSearcher полным перебором: на случайных малых графах
+// (ориентированных и неориентированных) для каждой пары вершин (v, w) перебираются
+// все простые пути из v в w с их стоимостью и ресурсом, и для каждого бюджета
+// 0..MAX_BUDGET сравниваются:
+// distance() - с наименьшей стоимостью пути, ресурс которого не больше бюджета;
+// path() и get_path() - путь графа из v в w с этой стоимостью и допустимым ресурсом;
+// pareto() - с множеством пар (стоимость, ресурс) путей перебора, не подчиненных
+// другим путям в пределах бюджета.
+// Ресурс дуги - 1 (ограничение количества дуг) либо значение функции mixed().
+//
+// Вызов: check_constrained [-i iterations] [--seed seed]
+// -i - количество случайных графов (по умолчанию 200);
+// --seed - начальное значение генератора графов (по умолчанию 1).
+// При первом расхождении выводится описание графа и запроса, и программа
+// завершается с кодом 1.
+
+#include "GraphObserver.cpp"
+#include "SparseGraph.cpp"
+#include "CsrGraph.cpp"
+#include "SearchControl.cpp"
+#include "SearchStats.cpp"
+#include "PathTracer.cpp"
+#include "ConstrainedPathSearcher.cpp"
+#include "GraphGenerator.cpp"
+
+#include <set>
+
+using namespace std;
+
+static const int MAX_V = 8, DEGREE = 3, MAX_COST = 9, MAX_BUDGET = 12;
+
+// Ресурс дуги (v, w) стоимостью c во втором режиме проверки.
+static int mixed(int v, int w, int c) { return (v * 7 + w * 3 + c) % 5; }
+
+// Функция перебора всех простых путей из вершины u в вершину w: пара (стоимость,
+// ресурс) каждого найденного пути добавляется в out. on[x] - вершина x уже есть в
+// текущем пути.
+static void enumerate(const SparseGraph &G, const function<int(int, int, int)> &resource,
+		int u, int w, int cost, int res, vector<char> &on, vector<pair<int, int>> &out)
+{
+	if(u == w) {
+		out.push_back({cost, res});
+		return;
+	}
+	on[u] = 1;
+	SparseGraph::adjIterator A(G, u);
+	for(int x = A.begin(); !A.end(); x = A.next())
+		if(!on[x])
+			enumerate(G, resource, x, w, cost + A.cost(), res + resource(u, x, A.cost()), on, out);
+	on[u] = 0;
+}
+
+// Функция проверки пути p: путь графа G из v в w стоимостью cost и ресурсом res.
+static bool valid(const SparseGraph &G, const function<int(int, int, int)> &resource,
+		const vector<int> &p, int v, int w, int cost, int res)
+{
+	if(p.empty() || p.front() != v || p.back() != w)
+		return false;
+	long long sum_c = 0, sum_r = 0;
+	for(size_t i = 0; i + 1 < p.size(); ++i) {
+		int c = G.edge(p[i], p[i + 1]);
+		if(!c)
+			return false;
+		sum_c += c;
+		sum_r += resource(p[i], p[i + 1], c);
+	}
+	return sum_c == cost && sum_r == res;
+}
+
+// Функция проверки всех пар вершин и бюджетов графа G. Возвращает количество
+// проверенных запросов либо -1 при расхождении (описание выводится в cerr).
+static long long check(const SparseGraph &G, bool hops, const string &name) {
+	function<int(int, int, int)> resource = [&](int v, int w, int c) {
+		return hops ? 1 : mixed(v, w, c);
+	};
+	unique_ptr<ConstrainedPathSearcher<SparseGraph>> CS(hops ?
+		new ConstrainedPathSearcher<SparseGraph>(G) :
+		new ConstrainedPathSearcher<SparseGraph>(G, resource));
+	long long queries = 0;
+	for(int v = 0; v < G.V(); ++v)
+		for(int w = 0; w < G.V(); ++w) {
+			vector<pair<int, int>> all;
+			vector<char> on(G.V(), 0);
+			enumerate(G, resource, v, w, 0, 0, on, all);
+			for(int budget = 0; budget <= MAX_BUDGET; ++budget) {
+				++queries;
+				int best = INF_COST;
+				set<pair<int, int>> front;
+				for(auto &p : all) {
+					if(p.second > budget)
+						continue;
+					best = min(best, p.first);
+					bool dominated = false;
+					for(auto &q : all)
+						if(q.second <= budget && q != p && q.first <= p.first && q.second <= p.second)
+							dominated = true;
+					if(!dominated)
+						front.insert(p);
+				}
+
+				string what;
+				vector<int> path = CS->path(v, w, budget);
+				int res = 0;
+				for(size_t i = 0; i + 1 < path.size(); ++i)
+					res += resource(path[i], path[i + 1], G.edge(path[i], path[i + 1]));
+				if(CS->distance(v, w, budget) != best)
+					what = "distance";
+				else if(best == INF_COST ? !path.empty() :
+						res > budget || !valid(G, resource, path, v, w, best, res))
+					what = "path";
+				else if(best == INF_COST ? CS->get_path(v, w, budget) != PathTracer::format(v, w) :
+						CS->get_path(v, w, budget) != PathTracer::format(path, best))
+					what = "get_path";
+				else {
+					set<pair<int, int>> got;
+					for(auto &r : CS->pareto(v, w, budget))
+						if(r.resource <= budget && valid(G, resource, r.path, v, w, r.cost, r.resource))
+							got.insert({r.cost, r.resource});
+					if(got != front)
+						what = "pareto";
+				}
+				if(!what.empty()) {
+					cerr << name << ": " << what << "(" << v << ", " << w << ", " << budget
+						<< ") differs from enumeration of " << all.size() << " simple paths" << endl;
+					return -1;
+				}
+			}
+		}
+	return queries;
+}
+
+int main(int argc, char const *argv[]) {
+	int iterations = 200;
+	unsigned long long seed = 1;
+	for(int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if(arg == "-i" && i + 1 < argc)
+			iterations = max(atoi(argv[++i]), 1);
+		else if(arg == "--seed" && i + 1 < argc)
+			seed = strtoull(argv[++i], nullptr, 10);
+		else {
+			cerr << "Wrong call" << endl;
+			return 1;
+		}
+	}
+
+	mt19937_64 rng(seed);
+	long long queries = 0;
+	for(int it = 0; it < iterations; ++it) {
+		int V = 2 + rng() % (MAX_V - 1);
+		long long E = rng() % (DEGREE * V + 1);
+		bool directed = it % 2, hops = it % 4 < 2;
+		vector<Edge> edges;
+		GraphGenerator::erdos_renyi(edges, V, E, rng(), MAX_COST);
+
+		SparseGraph G(V, directed);
+		for(auto &e : edges)
+			G.insert(e);
+		string name = "graph " + to_string(it) + " (V = " + to_string(V) + ", " +
+			(directed ? "directed" : "undirected") + ", " + (hops ? "hops" : "resource") + ")";
+		long long q = check(G, hops, name);
+		if(q < 0) {
+			cerr << GraphGenerator::to_list(edges);
+			return 1;
+		}
+		queries += q;
+	}
+	cout << "ok: " << iterations << " graphs, " << queries << " queries" << endl;
+	return 0;
+}
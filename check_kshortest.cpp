@@ -0,0 +1,138 @@
+// Проверка KShortestSearcher полным перебором: на случайных малых графах
+// (ориентированных и неориентированных, DenseGraph и SparseGraph) для каждой
+// пары вершин (v, w) перебираются все простые пути из v в w, и результат
+// KShortestSearcher::paths(v, w, k) сравнивается с K наименьшими стоимостями
+// перебора. Проверяется, что найдено min(K, количество простых путей) путей, их
+// стоимости совпадают с отсортированными стоимостями перебора, каждый путь -
+// простой путь графа из v в w с указанной стоимостью и пути не повторяются.
+//
+// Вызов: check_kshortest [-i iterations] [--seed seed]
+// -i - количество случайных графов каждого представления (по умолчанию 200);
+// --seed - начальное значение генератора графов (по умолчанию 1).
+// При первом расхождении выводится описание графа и запроса, и программа
+// завершается с кодом 1.
+
+#include "GraphObserver.cpp"
+#include "SparseGraph.cpp"
+#include "DenseGraph.cpp"
+#include "CsrGraph.cpp"
+#include "SearchControl.cpp"
+#include "SearchStats.cpp"
+#include "PathTracer.cpp"
+#include "DaryHeap.cpp"
+#include "KShortestSearcher.cpp"
+#include "GraphGenerator.cpp"
+
+using namespace std;
+
+static const int MAX_V = 8, DEGREE = 3, MAX_COST = 9;
+
+// Функция перебора всех простых путей из вершины u в вершину w: стоимость каждого
+// найденного пути добавляется в costs. on[x] - вершина x уже есть в текущем пути.
+template<typename Graph>
+static void enumerate(const Graph &G, int u, int w, int cost, vector<char> &on, vector<int> &costs) {
+	if(u == w) {
+		costs.push_back(cost);
+		return;
+	}
+	on[u] = 1;
+	typename Graph::adjIterator A(G, u);
+	for(int x = A.begin(); !A.end(); x = A.next())
+		if(!on[x])
+			enumerate(G, x, w, cost + A.cost(), on, costs);
+	on[u] = 0;
+}
+
+// Функция проверки пути p: простой путь графа G из v в w стоимостью cost.
+template<typename Graph>
+static bool valid(const Graph &G, const vector<int> &p, int v, int w, int cost) {
+	if(p.empty() || p.front() != v || p.back() != w)
+		return false;
+	vector<char> on(G.V(), 0);
+	long long sum = 0;
+	for(size_t i = 0; i < p.size(); ++i) {
+		if(on[p[i]])
+			return false;
+		on[p[i]] = 1;
+		if(i + 1 < p.size()) {
+			int c = G.edge(p[i], p[i + 1]);
+			if(!c)
+				return false;
+			sum += c;
+		}
+	}
+	return sum == cost;
+}
+
+// Функция проверки всех пар вершин графа G. Возвращает количество проверенных
+// запросов либо -1 при расхождении (описание выводится в cerr).
+template<typename Graph>
+static long long check(const Graph &G, const string &name) {
+	KShortestSearcher<Graph> KS(G);
+	long long queries = 0;
+	for(int v = 0; v < G.V(); ++v)
+		for(int w = 0; w < G.V(); ++w) {
+			vector<int> costs;
+			vector<char> on(G.V(), 0);
+			enumerate(G, v, w, 0, on, costs);
+			sort(costs.begin(), costs.end());
+			for(int k : {1, 2, 3, 5, (int)costs.size() + 1}) {
+				++queries;
+				auto res = KS.paths(v, w, k);
+				bool ok = res.size() == min((size_t)k, costs.size());
+				set<vector<int>> seen;
+				for(size_t i = 0; ok && i < res.size(); ++i)
+					ok = res[i].cost == costs[i] && valid(G, res[i].path, v, w, res[i].cost) &&
+						seen.insert(res[i].path).second;
+				if(!ok) {
+					cerr << name << ": paths(" << v << ", " << w << ", " << k << ") found "
+						<< res.size() << " of " << costs.size() << " simple paths" << endl;
+					return -1;
+				}
+			}
+		}
+	return queries;
+}
+
+int main(int argc, char const *argv[]) {
+	int iterations = 200;
+	unsigned long long seed = 1;
+	for(int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if(arg == "-i" && i + 1 < argc)
+			iterations = max(atoi(argv[++i]), 1);
+		else if(arg == "--seed" && i + 1 < argc)
+			seed = strtoull(argv[++i], nullptr, 10);
+		else {
+			cerr << "Wrong call" << endl;
+			return 1;
+		}
+	}
+
+	mt19937_64 rng(seed);
+	long long queries = 0;
+	for(int it = 0; it < iterations; ++it) {
+		int V = 2 + rng() % (MAX_V - 1);
+		long long E = rng() % (DEGREE * V + 1);
+		bool directed = it % 2;
+		vector<Edge> edges;
+		GraphGenerator::erdos_renyi(edges, V, E, rng(), MAX_COST);
+
+		DenseGraph dense(V, directed);
+		SparseGraph sparse(V, directed);
+		for(auto &e : edges) {
+			dense.insert(e);
+			sparse.insert(e);
+		}
+		string name = "graph " + to_string(it) + " (V = " + to_string(V) + ", " +
+			(directed ? "directed" : "undirected") + ")";
+		long long d = check(dense, name + ", dense"), s = check(sparse, name + ", sparse");
+		if(d < 0 || s < 0) {
+			cerr << GraphGenerator::to_list(edges);
+			return 1;
+		}
+		queries += d + s;
+	}
+	cout << "ok: " << 2 * iterations << " graphs, " << queries << " queries" << endl;
+	return 0;
+}
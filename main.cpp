@@ -1,11 +1,40 @@
 // ДАННЫЙ ФАЙЛ ПРЕДНАЗНАЧЕН ИСКЛЮЧИТЕЛЬНО ДЛЯ ТЕСТИРОВАНИЯ
 // И ОТЛАДКИ ПОДКЛЮЧЕННЫХ НИЖЕ КОМПОНЕНТОВ.
 
+#include "GraphObserver.cpp"
 #include "SparseGraph.cpp"
 #include "DenseGraph.cpp"
+#include "CsrGraph.cpp"
 #include "IO.cpp"
+#include "ThreadPool.cpp"
+#include "SearchControl.cpp"
+#include "SearchStats.cpp"
+#include "PathTracer.cpp"
 #include "ShortestPathSearcher.cpp"
 #include "DeepSearcher.cpp"
+#include "PathGenerator.cpp"
+#include "DaryHeap.cpp"
+#include "DijkstraSearcher.cpp"
+#include "AllPairsSearcher.cpp"
+#include "AltSearcher.cpp"
+#include "ContractionHierarchy.cpp"
+#include "DeltaSteppingSearcher.cpp"
+#include "DistanceStore.cpp"
+#include "RadixHeap.cpp"
+#include "BucketSearcher.cpp"
+#include "BatchSearcher.cpp"
+#include "MultiSourceBFS.cpp"
+#include "SccDecomposition.cpp"
+#include "DagSearcher.cpp"
+#include "ConstrainedPathSearcher.cpp"
+#include "KShortestSearcher.cpp"
+#include "ReachabilityIndex.cpp"
+#include "ResultCache.cpp"
+#include "SnapshotGraph.cpp"
+#include "ConcurrentGraphBuilder.cpp"
+#include "QueryServer.cpp"
+#include "GraphGenerator.cpp"
+#include "CountingGraph.cpp"
 
 using namespace std;
 
@@ -48,5 +77,11 @@ int main(int argc, char const *argv[]) {
 
 	// cout << SPS.get_path(2, 3) << endl;
 
+	// Поиск кратчайшего пути по запросу (без построения матрицы для всех пар):
+	DijkstraSearcher<Graph> DjS(graph);
+
+	cout << "\nShortest path from " << v << " to " << w << ":" << endl;
+	cout << DjS.get_path(v, w) << endl;
+
 	return 0;
 }
\ No newline at end of file
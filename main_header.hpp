@@ -6,7 +6,18 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <limits>
 #include <vector>
+#include <memory>
+#include <list>
+#include <unordered_map>
+#include <queue>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <random>
 #include <regex>
 
 using namespace std;
@@ -21,4 +32,13 @@ struct Edge {
 	Edge(int v = -1, int w = -1, unsigned c = 0) : v(v), w(w), c(c) { }
 };
 
+/*
+ * ~~~~ Описание константы:
+ * Стоимость, обозначающая отсутствие пути между вершинами ("бесконечность").
+ * ~~~~ Примечания:
+ * Равна половине максимального значения int, чтобы сумма двух таких значений
+ * не приводила к переполнению.
+*/
+const int INF_COST = numeric_limits<int>::max() / 2;
+
 #endif // _MAIN_G_HEADER_
\ No newline at end of file
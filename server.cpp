@@ -0,0 +1,115 @@
+// Сервер запросов к графу (см. QueryServer): граф загружается один раз, далее
+// запросы принимаются из стандартного ввода или через Unix-сокет.
+//
+// Вызов: server [-t threads] [-s socket] [-n V] [-c bytes] [-d ms] [--sparse] [--undirected] file
+// -t - количество потоков пула (по умолчанию - количество аппаратных потоков);
+// -s - путь Unix-сокета (по умолчанию запросы читаются из стандартного ввода, ответы
+// записываются в стандартный вывод);
+// -n - количество вершин (по умолчанию - количество непустых строк файла для
+// матрицы смежности и наибольший номер вершины + 1 для списка ребер);
+// -c - ограничение памяти кэша ответов в байтах (по умолчанию кэш отключен);
+// -d - срок выполнения одного запроса в миллисекундах (по умолчанию без ограничения);
+// --sparse - файл содержит список ребер "v-w, c;" (формат SparseGraph), иначе -
+// матрицу смежности (формат DenseGraph);
+// --undirected - граф ненаправленный.
+
+#include "GraphObserver.cpp"
+#include "SparseGraph.cpp"
+#include "DenseGraph.cpp"
+#include "CsrGraph.cpp"
+#include "ThreadPool.cpp"
+#include "SearchControl.cpp"
+#include "SearchStats.cpp"
+#include "ConcurrentGraphBuilder.cpp"
+#include "PathTracer.cpp"
+#include "DeepSearcher.cpp"
+#include "PathGenerator.cpp"
+#include "DaryHeap.cpp"
+#include "DijkstraSearcher.cpp"
+#include "SccDecomposition.cpp"
+#include "ReachabilityIndex.cpp"
+#include "DagSearcher.cpp"
+#include "KShortestSearcher.cpp"
+#include "ResultCache.cpp"
+#include "QueryServer.cpp"
+
+#include <csignal>
+
+using namespace std;
+
+int main(int argc, char const *argv[]) {
+	int threads = 0, V = -1;
+	size_t cache_bytes = 0;
+	long long deadline_ms = 0;
+	string socket_path, filename;
+	bool sparse = false, directed = true;
+	for(int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if(arg == "-t" && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if(arg == "-s" && i + 1 < argc)
+			socket_path = argv[++i];
+		else if(arg == "-n" && i + 1 < argc)
+			V = atoi(argv[++i]);
+		else if(arg == "-c" && i + 1 < argc)
+			cache_bytes = strtoull(argv[++i], nullptr, 10);
+		else if(arg == "-d" && i + 1 < argc)
+			deadline_ms = atoll(argv[++i]);
+		else if(arg == "--sparse")
+			sparse = true;
+		else if(arg == "--undirected")
+			directed = false;
+		else
+			filename = arg;
+	}
+	if(filename.empty()) {
+		cerr << "Wrong call" << endl;
+		return 1;
+	}
+
+	ifstream fin(filename);
+	if(!fin.is_open()) {
+		cerr << "reading error" << endl;
+		return 1;
+	}
+	string data, line;
+	int lines = 0;
+	while(getline(fin, line)) {
+		lines += (line.find_first_not_of(" \t\r") != string::npos);
+		data += line + '\n';
+	}
+
+	// Ребра распознаются функциями scan_edges() классов графов проекта; граф сразу
+	// строится в CSR-представлении, без промежуточного DenseGraph или SparseGraph.
+	vector<Edge> edges;
+	if(sparse)
+		SparseGraph::scan_edges(edges, data);
+	else
+		DenseGraph::scan_edges(edges, data);
+	if(V < 0) {
+		V = (sparse ? 0 : lines);
+		for(auto &e : edges)
+			V = max(V, max(e.v, e.w) + 1);
+	}
+	// Ребра с некорректными номерами вершин пропускаются построителем; обратные дуги
+	// неориентированного графа добавляются так же, как SparseGraph::insert().
+	ConcurrentGraphBuilder builder(V, directed);
+	for(auto &e : edges)
+		builder.insert(0, e);
+	CsrGraph graph = builder.build(threads);
+	cerr << "loaded " << filename << ": |V| = " << graph.V() << ", |E| = " << graph.E() << endl;
+
+	// Закрытое клиентом соединение не должно завершать сервер.
+	signal(SIGPIPE, SIG_IGN);
+
+	QueryServer server(graph, threads, cache_bytes, deadline_ms);
+	if(!socket_path.empty()) {
+		if(!server.listen(socket_path)) {
+			cerr << "socket error: " << socket_path << endl;
+			return 1;
+		}
+		return 0;
+	}
+	server.serve(0, 1);
+	return 0;
+}